@@ -0,0 +1,93 @@
+#include "gdwg/bfs.hpp"
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+	// R-MAT graph (Chakrabarti et al.) with 2^scale nodes and edge_factor edges per node, using the
+	// Graph500 quadrant probabilities (0.57, 0.19, 0.19, 0.05): a skewed, small-world degree
+	// distribution like that of real networks. Duplicate edges collapse.
+	auto make_rmat_graph(int scale, int edge_factor) -> gdwg::csr_graph<int, int> {
+		using value_type = gdwg::graph<int, int>::value_type;
+		auto rng = std::mt19937_64{6771};
+		auto quadrant = std::uniform_real_distribution<double>{0, 1};
+		auto edges = std::vector<value_type>();
+		edges.reserve((std::size_t{1} << scale) * static_cast<std::size_t>(edge_factor));
+		while (edges.size() < edges.capacity()) {
+			auto from = 0;
+			auto to = 0;
+			for (auto bit = 0; bit < scale; ++bit) {
+				auto const p = quadrant(rng);
+				from |= (p >= 0.57 + 0.19 ? 1 : 0) << bit;
+				to |= ((p >= 0.57 and p < 0.57 + 0.19) or p >= 0.57 + 0.19 + 0.19 ? 1 : 0) << bit;
+			}
+			edges.push_back(value_type{from, to, 0});
+		}
+		std::sort(edges.begin(), edges.end(), [](value_type const& a, value_type const& b) {
+			return std::tie(a.from, a.to) < std::tie(b.from, b.to);
+		});
+		auto nodes = std::vector<int>(std::size_t{1} << scale);
+		std::iota(nodes.begin(), nodes.end(), 0);
+		auto const g = gdwg::graph<int, int>(nodes.begin(), nodes.end(), edges.begin(), edges.end());
+		return gdwg::csr_graph(g);
+	}
+
+	// Scale 19 with 22 edges per node: 512Ki nodes, and enough edges that more than 10M are left
+	// once duplicates collapse. The benchmarks report the count as the edges counter.
+	auto rmat_graph() -> gdwg::csr_graph<int, int> const& {
+		static auto const g = make_rmat_graph(19, 22);
+		return g;
+	}
+
+	auto report_edges(benchmark::State& state, gdwg::csr_graph<int, int> const& g) -> void {
+		auto const edges = static_cast<std::int64_t>(g.num_edges());
+		// Traversed edges per second, as Graph500 reports it.
+		state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * edges);
+		state.counters["edges"] = static_cast<double>(edges);
+	}
+
+	void bm_bfs_levels_rmat(benchmark::State& state) {
+		auto const& g = rmat_graph();
+		auto pool = gdwg::thread_pool(static_cast<std::size_t>(state.range(0)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::bfs_levels(g, 0, pool));
+		}
+		report_edges(state, g);
+	}
+	BENCHMARK(bm_bfs_levels_rmat)
+	   ->ArgName("threads")
+	   ->RangeMultiplier(2)
+	   ->Range(1, static_cast<std::int64_t>(std::max(1U, std::thread::hardware_concurrency())))
+	   ->Unit(benchmark::kMillisecond)
+	   ->UseRealTime();
+
+	// A plain serial top-down search over the same snapshot, for comparison.
+	void bm_bfs_top_down_rmat(benchmark::State& state) {
+		auto const& g = rmat_graph();
+		for (auto _ : state) {
+			auto depths = std::vector<std::size_t>(g.num_nodes(), g.num_nodes());
+			auto queue = std::deque<std::size_t>{0};
+			depths[0] = 0;
+			while (not queue.empty()) {
+				auto const from = queue.front();
+				queue.pop_front();
+				for (auto const to : g.out_targets(from)) {
+					if (depths[to] == g.num_nodes()) {
+						depths[to] = depths[from] + 1;
+						queue.push_back(to);
+					}
+				}
+			}
+			benchmark::DoNotOptimize(depths);
+		}
+		report_edges(state, g);
+	}
+	BENCHMARK(bm_bfs_top_down_rmat)->Unit(benchmark::kMillisecond)->UseRealTime();
+} // namespace
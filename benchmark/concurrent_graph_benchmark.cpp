@@ -0,0 +1,85 @@
+#include "gdwg/concurrent_graph.hpp"
+#include "random_graph.hpp"
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace {
+	using benchmark_util::make_random_graph;
+
+	constexpr auto num_nodes = 1 << 14;
+
+	// The baseline concurrent_graph replaces: a graph behind a reader-writer lock.
+	class shared_mutex_graph {
+	public:
+		explicit shared_mutex_graph(gdwg::graph<int, int> g)
+		: g_{std::move(g)} {}
+
+		auto weights(int src, int dest) const -> std::vector<int> {
+			auto const lock = std::shared_lock(mutex_);
+			return g_.weights(src, dest);
+		}
+
+		template<typename F>
+		auto write(F&& f) -> void {
+			auto const lock = std::unique_lock(mutex_);
+			f(g_);
+		}
+
+	private:
+		gdwg::graph<int, int> g_;
+		mutable std::shared_mutex mutex_;
+	};
+
+	// Thread 0 writes without pause, adding and removing an edge; every other thread looks up
+	// weights. Items are reads, so items_per_second is the total read throughput while writes go
+	// on. With one thread there is no writer.
+	template<typename Graph>
+	void bm_reads_during_writes(benchmark::State& state) {
+		static auto g = Graph(make_random_graph(num_nodes));
+		auto src = state.thread_index() * 7919 % num_nodes;
+		auto const writer = state.threads() > 1 and state.thread_index() == 0;
+		for (auto _ : state) {
+			if (writer) {
+				g.write([src](gdwg::graph<int, int>& graph) {
+					if (not graph.erase_edge(src, src, -1)) {
+						graph.insert_edge(src, src, -1);
+					}
+				});
+			}
+			else {
+				benchmark::DoNotOptimize(g.weights(src, (src * 7) % num_nodes));
+			}
+			src = (src + 1) % num_nodes;
+		}
+		if (not writer) {
+			state.SetItemsProcessed(state.iterations());
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_reads_during_writes, gdwg::concurrent_graph<int, int>)
+	   ->ThreadRange(1, 32)
+	   ->UseRealTime();
+	BENCHMARK_TEMPLATE(bm_reads_during_writes, shared_mutex_graph)
+	   ->ThreadRange(1, 32)
+	   ->UseRealTime();
+
+	// Cost of a single write, which concurrent_graph applies to both of its copies.
+	template<typename Graph>
+	void bm_write(benchmark::State& state) {
+		auto g = Graph(make_random_graph(num_nodes));
+		auto src = 0;
+		for (auto _ : state) {
+			g.write([src](gdwg::graph<int, int>& graph) {
+				if (not graph.erase_edge(src, src, -1)) {
+					graph.insert_edge(src, src, -1);
+				}
+			});
+			src = (src + 1) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_write, gdwg::concurrent_graph<int, int>);
+	BENCHMARK_TEMPLATE(bm_write, shared_mutex_graph);
+} // namespace
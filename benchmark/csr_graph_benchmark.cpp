@@ -0,0 +1,110 @@
+#include "gdwg/csr_graph.hpp"
+#include "random_graph.hpp"
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace {
+	using benchmark_util::make_random_graph;
+
+	// The same query stream against the tree-based graph and its CSR snapshot.
+	template<typename Graph>
+	void bm_weights(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = Graph(make_random_graph(num_nodes));
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.weights(src, (src * 7) % num_nodes));
+			src = (src + 1) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_weights, gdwg::graph<int, int>)
+	   ->RangeMultiplier(8)
+	   ->Range(1 << 8, 1 << 17);
+	BENCHMARK_TEMPLATE(bm_weights, gdwg::csr_graph<int, int>)
+	   ->RangeMultiplier(8)
+	   ->Range(1 << 8, 1 << 17);
+
+	template<typename Graph>
+	void bm_connections(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = Graph(make_random_graph(num_nodes));
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.connections(src));
+			src = (src + 1) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_connections, gdwg::graph<int, int>)
+	   ->RangeMultiplier(8)
+	   ->Range(1 << 8, 1 << 17);
+	BENCHMARK_TEMPLATE(bm_connections, gdwg::csr_graph<int, int>)
+	   ->RangeMultiplier(8)
+	   ->Range(1 << 8, 1 << 17);
+
+	template<typename Graph>
+	void bm_iteration(benchmark::State& state) {
+		auto const g = Graph(make_random_graph(static_cast<int>(state.range(0))));
+		for (auto _ : state) {
+			auto sum = 0;
+			for (auto const& [from, to, weight] : g) {
+				sum += weight;
+			}
+			benchmark::DoNotOptimize(sum);
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_iteration, gdwg::graph<int, int>)
+	   ->RangeMultiplier(8)
+	   ->Range(1 << 8, 1 << 17);
+	BENCHMARK_TEMPLATE(bm_iteration, gdwg::csr_graph<int, int>)
+	   ->RangeMultiplier(8)
+	   ->Range(1 << 8, 1 << 17);
+
+	// Getting a queryable snapshot: building it from a graph versus mapping one written earlier.
+	// Splitting the edges into even parts, as a parallel algorithm does before handing them out:
+	// O(e) std::next over the graph's bidirectional iterators, O(parts log n) jumps over CSR.
+	template<typename Graph>
+	void bm_split_edges(benchmark::State& state) {
+		constexpr auto parts = 64;
+		auto const g = Graph(make_random_graph(static_cast<int>(state.range(0))));
+		auto const part_size = static_cast<std::ptrdiff_t>(g.num_edges()) / parts;
+		for (auto _ : state) {
+			auto itor = g.begin();
+			for (auto part = 1; part < parts; ++part) {
+				itor = std::next(itor, part_size);
+				benchmark::DoNotOptimize(itor);
+			}
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_split_edges, gdwg::graph<int, int>)
+	   ->RangeMultiplier(8)
+	   ->Range(1 << 8, 1 << 17);
+	BENCHMARK_TEMPLATE(bm_split_edges, gdwg::csr_graph<int, int>)
+	   ->RangeMultiplier(8)
+	   ->Range(1 << 8, 1 << 17);
+
+	void bm_build_snapshot(benchmark::State& state) {
+		auto const g = make_random_graph(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::csr_graph(g));
+		}
+	}
+	BENCHMARK(bm_build_snapshot)->RangeMultiplier(8)->Range(1 << 8, 1 << 17);
+
+	void bm_map_snapshot(benchmark::State& state) {
+		auto const path = std::filesystem::temp_directory_path() / "gdwg_csr_graph_benchmark.bin";
+		{
+			auto out = std::ofstream(path, std::ios::binary);
+			gdwg::csr_graph(make_random_graph(static_cast<int>(state.range(0)))).write_binary(out);
+		}
+		for (auto _ : state) {
+			auto const mapped = gdwg::csr_graph<int, int>::map_binary(path);
+			// Touch one node so the mapping is actually used.
+			benchmark::DoNotOptimize(mapped.is_node(0));
+		}
+		std::filesystem::remove(path);
+	}
+	BENCHMARK(bm_map_snapshot)->RangeMultiplier(8)->Range(1 << 8, 1 << 17);
+} // namespace
@@ -0,0 +1,284 @@
+#include "gdwg/graph.hpp"
+#include "random_graph.hpp"
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	using benchmark_util::average_degree;
+	using benchmark_util::graph_shapes;
+	using benchmark_util::make_random_graph;
+	using benchmark_util::make_value;
+
+	// Growth with the number of edges at a fixed degree; these should fit O(log e).
+	void bm_connections_complexity(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_random_graph(num_nodes);
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.connections(src));
+			src = (src + 1) % num_nodes;
+		}
+		state.SetComplexityN(state.range(0) * average_degree);
+	}
+	BENCHMARK(bm_connections_complexity)->RangeMultiplier(4)->Range(1 << 8, 1 << 16)->Complexity();
+
+	void bm_weights_complexity(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_random_graph(num_nodes);
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.weights(src, (src * 7) % num_nodes));
+			src = (src + 1) % num_nodes;
+		}
+		state.SetComplexityN(state.range(0) * average_degree);
+	}
+	BENCHMARK(bm_weights_complexity)->RangeMultiplier(4)->Range(1 << 8, 1 << 16)->Complexity();
+
+	void bm_is_connected_complexity(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_random_graph(num_nodes);
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.is_connected(src, (src * 7) % num_nodes));
+			src = (src + 1) % num_nodes;
+		}
+		state.SetComplexityN(state.range(0) * average_degree);
+	}
+	BENCHMARK(bm_is_connected_complexity)->RangeMultiplier(4)->Range(1 << 8, 1 << 16)->Complexity();
+
+	// One hub with an out-edge to every other node; queries to its last destination should stay
+	// O(log e) rather than grow with the hub's degree.
+	auto make_hub_graph(int num_nodes) -> gdwg::graph<int, int> {
+		auto g = gdwg::graph<int, int>{};
+		for (auto i = 0; i < num_nodes; ++i) {
+			g.insert_node(i);
+		}
+		for (auto dest = 1; dest < num_nodes; ++dest) {
+			g.insert_edge(0, dest, dest);
+		}
+		return g;
+	}
+
+	void bm_weights_hub(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_hub_graph(num_nodes);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.weights(0, num_nodes - 1));
+		}
+		state.SetComplexityN(state.range(0));
+	}
+	BENCHMARK(bm_weights_hub)->RangeMultiplier(8)->Range(1 << 8, 1 << 20)->Complexity();
+
+	void bm_weights_view_hub(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_hub_graph(num_nodes);
+		for (auto _ : state) {
+			for (auto const& weight : g.weights_view(0, num_nodes - 1)) {
+				benchmark::DoNotOptimize(&weight);
+			}
+		}
+		state.SetComplexityN(state.range(0));
+	}
+	BENCHMARK(bm_weights_view_hub)->RangeMultiplier(8)->Range(1 << 8, 1 << 20)->Complexity();
+
+	void bm_is_connected_hub(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_hub_graph(num_nodes);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.is_connected(0, num_nodes - 1));
+		}
+		state.SetComplexityN(state.range(0));
+	}
+	BENCHMARK(bm_is_connected_hub)->RangeMultiplier(8)->Range(1 << 8, 1 << 20)->Complexity();
+
+	// Every accessor over the shared (nodes, degree) grid, for each node/weight type.
+	template<typename N, typename E>
+	void bm_is_node(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_random_graph<N, E>(num_nodes, static_cast<int>(state.range(1)));
+		auto i = 0;
+		for (auto _ : state) {
+			// Every other probe misses.
+			benchmark::DoNotOptimize(g.is_node(make_value<N>(i)));
+			i = (i + 1) % (2 * num_nodes);
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_is_node, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_is_node, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_is_connected(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_random_graph<N, E>(num_nodes, static_cast<int>(state.range(1)));
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(
+			   g.is_connected(make_value<N>(src), make_value<N>((src * 7) % num_nodes)));
+			src = (src + 1) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_is_connected, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_is_connected, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_nodes(benchmark::State& state) {
+		auto const g = make_random_graph<N, E>(static_cast<int>(state.range(0)),
+		                                       static_cast<int>(state.range(1)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.nodes());
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_nodes, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_nodes, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_weights(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_random_graph<N, E>(num_nodes, static_cast<int>(state.range(1)));
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.weights(make_value<N>(src), make_value<N>((src * 7) % num_nodes)));
+			src = (src + 1) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_weights, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_weights, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_find(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_random_graph<N, E>(num_nodes, static_cast<int>(state.range(1)));
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(
+			   g.find(make_value<N>(src), make_value<N>((src * 7) % num_nodes), make_value<E>(src % 101)));
+			src = (src + 1) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_find, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_find, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_connections(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_random_graph<N, E>(num_nodes, static_cast<int>(state.range(1)));
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.connections(make_value<N>(src)));
+			src = (src + 1) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_connections, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_connections, std::string, double)->Apply(graph_shapes);
+
+	// The views, walked to the end so they do the same work as the copies.
+	template<typename N, typename E>
+	void bm_nodes_view(benchmark::State& state) {
+		auto const g = make_random_graph<N, E>(static_cast<int>(state.range(0)),
+		                                       static_cast<int>(state.range(1)));
+		for (auto _ : state) {
+			for (auto const& value : g.nodes_view()) {
+				benchmark::DoNotOptimize(&value);
+			}
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_nodes_view, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_nodes_view, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_weights_view(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_random_graph<N, E>(num_nodes, static_cast<int>(state.range(1)));
+		auto src = 0;
+		for (auto _ : state) {
+			auto const src_value = make_value<N>(src);
+			auto const dest_value = make_value<N>((src * 7) % num_nodes);
+			for (auto const& weight : g.weights_view(src_value, dest_value)) {
+				benchmark::DoNotOptimize(&weight);
+			}
+			src = (src + 1) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_weights_view, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_weights_view, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_connections_view(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_random_graph<N, E>(num_nodes, static_cast<int>(state.range(1)));
+		auto src = 0;
+		for (auto _ : state) {
+			for (auto const& dest : g.connections_view(make_value<N>(src))) {
+				benchmark::DoNotOptimize(&dest);
+			}
+			src = (src + 1) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_connections_view, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_connections_view, std::string, double)->Apply(graph_shapes);
+
+	// The same queries through node ids looked up once up front, as a hot loop would hold them.
+	template<typename N, typename E>
+	auto node_ids(gdwg::graph<N, E> const& g, int num_nodes) {
+		auto ids = std::vector<typename gdwg::graph<N, E>::node_id>();
+		for (auto i = 0; i < num_nodes; ++i) {
+			ids.push_back(*g.find_node(make_value<N>(i)));
+		}
+		return ids;
+	}
+
+	template<typename N, typename E>
+	void bm_weights_by_id(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_random_graph<N, E>(num_nodes, static_cast<int>(state.range(1)));
+		auto const ids = node_ids(g, num_nodes);
+		auto src = std::size_t{0};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.weights_by_id(ids[src], ids[(src * 7) % ids.size()]));
+			src = (src + 1) % ids.size();
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_weights_by_id, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_weights_by_id, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_connections_by_id(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_random_graph<N, E>(num_nodes, static_cast<int>(state.range(1)));
+		auto const ids = node_ids(g, num_nodes);
+		auto src = std::size_t{0};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.connections_by_id(ids[src]));
+			src = (src + 1) % ids.size();
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_connections_by_id, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_connections_by_id, std::string, double)->Apply(graph_shapes);
+
+	// Nodes named past the small string buffer, so copying a name allocates. Key is how the
+	// caller holds the names it looks up.
+	template<typename Key>
+	void bm_find_long_names(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto names = std::vector<std::string>();
+		for (auto i = 0; i < num_nodes; ++i) {
+			names.push_back("a node with a name too long to store inline " + std::to_string(i));
+		}
+		auto g = gdwg::graph<std::string, int>(names.begin(), names.end());
+		for (auto i = 0; i < num_nodes; ++i) {
+			g.insert_edge(names[i], names[(i * 7) % num_nodes], i % 5);
+		}
+		auto const keys = std::vector<Key>(names.begin(), names.end());
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.find(keys[src], keys[(src * 7) % num_nodes], src % 5));
+			src = (src + 1) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_find_long_names, std::string)->Range(1 << 8, 1 << 14);
+	BENCHMARK_TEMPLATE(bm_find_long_names, std::string_view)->Range(1 << 8, 1 << 14);
+} // namespace
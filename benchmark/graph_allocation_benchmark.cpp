@@ -0,0 +1,81 @@
+#include "gdwg/graph.hpp"
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+// Counts every call to the global allocation function so the benchmarks can report how many heap
+// allocations each graph operation performs.
+namespace {
+	auto allocations = std::size_t{0};
+} // namespace
+
+auto operator new(std::size_t size) -> void* {
+	++allocations;
+	if (auto* ptr = std::malloc(size)) {
+		return ptr;
+	}
+	throw std::bad_alloc{};
+}
+
+auto operator delete(void* ptr) noexcept -> void {
+	std::free(ptr);
+}
+
+auto operator delete(void* ptr, std::size_t) noexcept -> void {
+	std::free(ptr);
+}
+
+namespace {
+	// Short enough for the small string optimisation, so only the graph's own allocations count.
+	auto node_name(int i) -> std::string {
+		return "n" + std::to_string(i);
+	}
+
+	void bm_insert_node_allocations(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto names = std::vector<std::string>{};
+		for (auto i = 0; i < num_nodes; ++i) {
+			names.push_back(node_name(i));
+		}
+		auto total = std::size_t{0};
+		for (auto _ : state) {
+			auto g = gdwg::graph<std::string, int>{};
+			auto const before = allocations;
+			for (auto const& name : names) {
+				g.insert_node(name);
+			}
+			total += allocations - before;
+		}
+		state.counters["allocs_per_node"] = benchmark::Counter(
+		   static_cast<double>(total) / static_cast<double>(state.iterations() * state.range(0)));
+	}
+	BENCHMARK(bm_insert_node_allocations)->Range(1 << 8, 1 << 14);
+
+	void bm_insert_edge_allocations(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto names = std::vector<std::string>{};
+		for (auto i = 0; i < num_nodes; ++i) {
+			names.push_back(node_name(i));
+		}
+		auto total = std::size_t{0};
+		for (auto _ : state) {
+			state.PauseTiming();
+			auto g = gdwg::graph<std::string, int>(names.begin(), names.end());
+			state.ResumeTiming();
+			auto const before = allocations;
+			for (auto i = 0; i < num_nodes; ++i) {
+				g.insert_edge(names[static_cast<std::size_t>(i)],
+				              names[static_cast<std::size_t>((i * 7) % num_nodes)],
+				              i);
+			}
+			total += allocations - before;
+		}
+		state.counters["allocs_per_edge"] = benchmark::Counter(
+		   static_cast<double>(total) / static_cast<double>(state.iterations() * state.range(0)));
+	}
+	BENCHMARK(bm_insert_edge_allocations)->Range(1 << 8, 1 << 14);
+} // namespace
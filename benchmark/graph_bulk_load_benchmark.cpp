@@ -0,0 +1,79 @@
+#include "gdwg/graph.hpp"
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace {
+	using graph = gdwg::graph<int, int>;
+	constexpr auto degree = 16;
+
+	// Sorted, duplicate-free edge stream over `num_nodes` nodes, as a nightly snapshot would be.
+	auto make_edge_stream(int num_nodes) -> std::vector<graph::value_type> {
+		auto rng = std::mt19937{6771};
+		auto node = std::uniform_int_distribution<int>{0, num_nodes - 1};
+		auto edges = std::vector<graph::value_type>{};
+		for (auto src = 0; src < num_nodes; ++src) {
+			for (auto i = 0; i < degree; ++i) {
+				edges.emplace_back(src, node(rng), i);
+			}
+		}
+		std::sort(edges.begin(), edges.end(), [](auto const& lhs, auto const& rhs) {
+			return std::tie(lhs.from, lhs.to, lhs.weight) < std::tie(rhs.from, rhs.to, rhs.weight);
+		});
+		return edges;
+	}
+
+	auto make_nodes(int num_nodes) -> std::vector<int> {
+		auto nodes = std::vector<int>(static_cast<std::size_t>(num_nodes));
+		std::iota(nodes.begin(), nodes.end(), 0);
+		return nodes;
+	}
+
+	void bm_insert_edge_loop(benchmark::State& state) {
+		auto const nodes = make_nodes(static_cast<int>(state.range(0)));
+		auto const edges = make_edge_stream(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			auto g = graph(nodes.begin(), nodes.end());
+			for (auto const& e : edges) {
+				g.insert_edge(e.from, e.to, e.weight);
+			}
+			benchmark::DoNotOptimize(g);
+		}
+		state.SetComplexityN(static_cast<std::int64_t>(edges.size()));
+	}
+	BENCHMARK(bm_insert_edge_loop)->RangeMultiplier(4)->Range(1 << 8, 1 << 14)->Complexity();
+
+	void bm_bulk_load(benchmark::State& state) {
+		auto const nodes = make_nodes(static_cast<int>(state.range(0)));
+		auto const edges = make_edge_stream(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			auto g = graph(nodes.begin(), nodes.end(), edges.begin(), edges.end());
+			benchmark::DoNotOptimize(g);
+		}
+		state.SetComplexityN(static_cast<std::int64_t>(edges.size()));
+	}
+	BENCHMARK(bm_bulk_load)->RangeMultiplier(4)->Range(1 << 8, 1 << 14)->Complexity();
+
+	// With hashed_index every destination jump is an O(1) lookup, so the load is linear.
+	void bm_bulk_load_hashed(benchmark::State& state) {
+		using hashed_graph = gdwg::graph<int, int, std::allocator<std::byte>, gdwg::hashed_index>;
+		auto const nodes = make_nodes(static_cast<int>(state.range(0)));
+		auto const edges = make_edge_stream(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			auto g = hashed_graph(nodes.begin(), nodes.end(), edges.begin(), edges.end());
+			benchmark::DoNotOptimize(g);
+		}
+		state.SetComplexityN(static_cast<std::int64_t>(edges.size()));
+	}
+	BENCHMARK(bm_bulk_load_hashed)
+	   ->RangeMultiplier(4)
+	   ->Range(1 << 8, 1 << 14)
+	   ->Complexity(benchmark::oN);
+} // namespace
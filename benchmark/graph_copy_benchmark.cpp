@@ -0,0 +1,62 @@
+#include "gdwg/graph.hpp"
+#include "random_graph.hpp"
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace {
+	using benchmark_util::graph_shapes;
+	using benchmark_util::make_random_graph;
+	using graph = gdwg::graph<int, int>;
+
+	// What the copy constructor used to do: look both endpoints up for every edge.
+	void bm_copy_by_insertion(benchmark::State& state) {
+		auto const g = make_random_graph(static_cast<int>(state.range(0)));
+		auto const nodes = g.nodes();
+		for (auto _ : state) {
+			auto copy = graph(nodes.begin(), nodes.end());
+			for (auto const& [from, to, weight] : g) {
+				copy.insert_edge(from, to, weight);
+			}
+			benchmark::DoNotOptimize(copy);
+		}
+		state.SetComplexityN(state.range(0) * benchmark_util::average_degree);
+	}
+	BENCHMARK(bm_copy_by_insertion)->RangeMultiplier(4)->Range(1 << 8, 1 << 14)->Complexity();
+
+	void bm_copy_constructor(benchmark::State& state) {
+		auto const g = make_random_graph(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			auto copy = g;
+			benchmark::DoNotOptimize(copy);
+		}
+		state.SetComplexityN(state.range(0) * benchmark_util::average_degree);
+	}
+	BENCHMARK(bm_copy_constructor)->RangeMultiplier(4)->Range(1 << 8, 1 << 14)->Complexity();
+
+	template<typename N, typename E>
+	void bm_copy(benchmark::State& state) {
+		auto const g = make_random_graph<N, E>(static_cast<int>(state.range(0)),
+		                                       static_cast<int>(state.range(1)));
+		for (auto _ : state) {
+			auto copy = g;
+			benchmark::DoNotOptimize(copy);
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_copy, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_copy, std::string, double)->Apply(graph_shapes);
+
+	// Assigning over a graph of the same shape also pays for tearing the old contents down.
+	template<typename N, typename E>
+	void bm_copy_assign(benchmark::State& state) {
+		auto const g = make_random_graph<N, E>(static_cast<int>(state.range(0)),
+		                                       static_cast<int>(state.range(1)));
+		auto copy = g;
+		for (auto _ : state) {
+			copy = g;
+			benchmark::DoNotOptimize(copy);
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_copy_assign, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_copy_assign, std::string, double)->Apply(graph_shapes);
+} // namespace
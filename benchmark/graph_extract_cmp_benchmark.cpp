@@ -0,0 +1,91 @@
+#include "gdwg/graph.hpp"
+#include "random_graph.hpp"
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	using benchmark_util::graph_shapes;
+	using benchmark_util::make_random_graph;
+
+	// Equal graphs have to be compared all the way through.
+	template<typename N, typename E>
+	void bm_equal(benchmark::State& state) {
+		auto const g = make_random_graph<N, E>(static_cast<int>(state.range(0)),
+		                                       static_cast<int>(state.range(1)));
+		auto const copy = g;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g == copy);
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_equal, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_equal, std::string, double)->Apply(graph_shapes);
+
+	// A million edges, with the copy built by inserting them in shuffled order so that its
+	// elements are not laid out in the original's order.
+	template<typename N, typename E>
+	void bm_equal_million_edges(benchmark::State& state) {
+		auto const g = make_random_graph<N, E>(1 << 16, 16);
+		auto edges = std::vector<typename gdwg::graph<N, E>::value_type>(g.begin(), g.end());
+		std::shuffle(edges.begin(), edges.end(), std::mt19937{1234});
+		auto const nodes = g.nodes();
+		auto other = gdwg::graph<N, E>(nodes.begin(), nodes.end());
+		for (auto const& [from, to, weight] : edges) {
+			other.insert_edge(from, to, weight);
+		}
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g == other);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.num_edges()));
+	}
+	BENCHMARK_TEMPLATE(bm_equal_million_edges, int, int)->Unit(benchmark::kMillisecond);
+	BENCHMARK_TEMPLATE(bm_equal_million_edges, std::string, double)->Unit(benchmark::kMillisecond);
+
+	// Same sizes, differing only in the weight of the last edge, which an element-wise comparison
+	// reaches last; the content hashes tell them apart at once.
+	template<typename N, typename E>
+	void bm_unequal(benchmark::State& state) {
+		auto const g = make_random_graph<N, E>(static_cast<int>(state.range(0)),
+		                                       static_cast<int>(state.range(1)));
+		auto other = g;
+		auto const last = *std::prev(g.end());
+		other.erase_edge(last.from, last.to, last.weight);
+		other.insert_edge(last.from, last.to, last.weight + 1);
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g == other);
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_unequal, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_unequal, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_hash(benchmark::State& state) {
+		auto const g = make_random_graph<N, E>(static_cast<int>(state.range(0)),
+		                                       static_cast<int>(state.range(1)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(std::hash<gdwg::graph<N, E>>{}(g));
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_hash, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_hash, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_extract(benchmark::State& state) {
+		auto const g = make_random_graph<N, E>(static_cast<int>(state.range(0)),
+		                                       static_cast<int>(state.range(1)));
+		for (auto _ : state) {
+			auto out = std::ostringstream{};
+			out << g;
+			benchmark::DoNotOptimize(out);
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_extract, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_extract, std::string, double)->Apply(graph_shapes);
+} // namespace
@@ -0,0 +1,63 @@
+#include "gdwg/graph.hpp"
+#include "random_graph.hpp"
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+namespace {
+	using benchmark_util::graph_shapes;
+	using benchmark_util::make_random_graph;
+	using benchmark_util::make_value;
+
+	// The lookups that hashed_index replaces, run against both node indexes.
+	template<typename N, typename Index>
+	void bm_is_node(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = make_random_graph<N, int, Index>(num_nodes, static_cast<int>(state.range(1)));
+		auto i = 0;
+		for (auto _ : state) {
+			// Every other probe misses.
+			benchmark::DoNotOptimize(g.is_node(make_value<N>(i)));
+			i = (i + 1) % (2 * num_nodes);
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_is_node, int, gdwg::ordered_index)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_is_node, int, gdwg::hashed_index)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_is_node, std::string, gdwg::ordered_index)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_is_node, std::string, gdwg::hashed_index)->Apply(graph_shapes);
+
+	template<typename N, typename Index>
+	void bm_insert_edge(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto g = make_random_graph<N, int, Index>(num_nodes, static_cast<int>(state.range(1)));
+		// Weights above the generator's range, so every insertion adds a new edge.
+		auto weight = 1000;
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(
+			   g.insert_edge(make_value<N>(src), make_value<N>((src * 7) % num_nodes), weight++));
+			src = (src + 1) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_insert_edge, int, gdwg::ordered_index)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_insert_edge, int, gdwg::hashed_index)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_insert_edge, std::string, gdwg::ordered_index)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_insert_edge, std::string, gdwg::hashed_index)->Apply(graph_shapes);
+
+	template<typename N, typename Index>
+	void bm_insert_node(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		for (auto _ : state) {
+			auto g = gdwg::graph<N, int, std::allocator<std::byte>, Index>{};
+			for (auto i = 0; i < num_nodes; ++i) {
+				g.insert_node(make_value<N>((i * 7919) % num_nodes));
+			}
+			benchmark::DoNotOptimize(g);
+		}
+		state.SetItemsProcessed(state.iterations() * num_nodes);
+	}
+	BENCHMARK_TEMPLATE(bm_insert_node, int, gdwg::ordered_index)->Range(1 << 8, 1 << 14);
+	BENCHMARK_TEMPLATE(bm_insert_node, int, gdwg::hashed_index)->Range(1 << 8, 1 << 14);
+	BENCHMARK_TEMPLATE(bm_insert_node, std::string, gdwg::ordered_index)->Range(1 << 8, 1 << 14);
+	BENCHMARK_TEMPLATE(bm_insert_node, std::string, gdwg::hashed_index)->Range(1 << 8, 1 << 14);
+} // namespace
@@ -0,0 +1,130 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/thread_pool.hpp"
+#include "random_graph.hpp"
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+	using benchmark_util::graph_shapes;
+	using benchmark_util::make_random_graph;
+
+	template<typename N, typename E>
+	void bm_iterate(benchmark::State& state) {
+		auto const g = make_random_graph<N, E>(static_cast<int>(state.range(0)),
+		                                       static_cast<int>(state.range(1)));
+		auto edges = std::int64_t{0};
+		for (auto _ : state) {
+			for (auto const& [from, to, weight] : g) {
+				benchmark::DoNotOptimize(from);
+				benchmark::DoNotOptimize(to);
+				benchmark::DoNotOptimize(weight);
+				++edges;
+			}
+		}
+		state.SetItemsProcessed(edges);
+	}
+	BENCHMARK_TEMPLATE(bm_iterate, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_iterate, std::string, double)->Apply(graph_shapes);
+
+	// Each edge copied out as a value_type, which every dereference did before iterators yielded
+	// references.
+	template<typename N, typename E>
+	void bm_iterate_copies(benchmark::State& state) {
+		auto const g = make_random_graph<N, E>(static_cast<int>(state.range(0)),
+		                                       static_cast<int>(state.range(1)));
+		auto edges = std::int64_t{0};
+		for (auto _ : state) {
+			for (auto it = g.begin(); it != g.end(); ++it) {
+				typename gdwg::graph<N, E>::value_type const edge = *it;
+				benchmark::DoNotOptimize(edge);
+				++edges;
+			}
+		}
+		state.SetItemsProcessed(edges);
+	}
+	BENCHMARK_TEMPLATE(bm_iterate_copies, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_iterate_copies, std::string, double)->Apply(graph_shapes);
+
+	// Names and weights past the small string buffer, so each copied edge allocates three times.
+	auto make_long_name_graph(int num_nodes) -> gdwg::graph<std::string, std::string> {
+		auto const name = [](int i) {
+			return "a node with a name too long to store inline " + std::to_string(i);
+		};
+		auto g = gdwg::graph<std::string, std::string>{};
+		for (auto i = 0; i < num_nodes; ++i) {
+			g.insert_node(name(i));
+		}
+		for (auto i = 0; i < num_nodes; ++i) {
+			for (auto step : {1, 7, 31}) {
+				g.insert_edge(name(i), name((i * step) % num_nodes), name(step) + " as a weight");
+			}
+		}
+		return g;
+	}
+
+	template<bool Copy>
+	void bm_iterate_long_names(benchmark::State& state) {
+		auto const g = make_long_name_graph(static_cast<int>(state.range(0)));
+		auto edges = std::int64_t{0};
+		for (auto _ : state) {
+			for (auto it = g.begin(); it != g.end(); ++it) {
+				if constexpr (Copy) {
+					gdwg::graph<std::string, std::string>::value_type const edge = *it;
+					benchmark::DoNotOptimize(edge);
+				}
+				else {
+					auto const& [from, to, weight] = *it;
+					benchmark::DoNotOptimize(from);
+					benchmark::DoNotOptimize(to);
+					benchmark::DoNotOptimize(weight);
+				}
+				++edges;
+			}
+		}
+		state.SetItemsProcessed(edges);
+	}
+	BENCHMARK_TEMPLATE(bm_iterate_long_names, false)->Range(1 << 8, 1 << 14);
+	BENCHMARK_TEMPLATE(bm_iterate_long_names, true)->Range(1 << 8, 1 << 14);
+
+	template<typename N, typename E>
+	void bm_iterate_backwards(benchmark::State& state) {
+		auto const g = make_random_graph<N, E>(static_cast<int>(state.range(0)),
+		                                       static_cast<int>(state.range(1)));
+		auto edges = std::int64_t{0};
+		for (auto _ : state) {
+			for (auto it = g.end(); it != g.begin();) {
+				benchmark::DoNotOptimize(*--it);
+				++edges;
+			}
+		}
+		state.SetItemsProcessed(edges);
+	}
+	BENCHMARK_TEMPLATE(bm_iterate_backwards, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_iterate_backwards, std::string, double)->Apply(graph_shapes);
+
+	// Per-edge work over edge_partitions on a thread pool, partitioning included. Each thread gets
+	// several partitions, so the pool's shared task counter evens out what the cuts cannot.
+	void bm_partitioned_for_each(benchmark::State& state) {
+		auto const threads = static_cast<std::size_t>(state.range(0));
+		auto const g = make_random_graph<std::string, double>(1 << 14);
+		auto pool = gdwg::thread_pool(threads);
+		auto sums = std::vector<double>(4 * threads);
+		for (auto _ : state) {
+			auto const partitions = g.edge_partitions(sums.size());
+			pool.run(partitions.size(), [&](std::size_t p) {
+				auto sum = 0.0;
+				for (auto const& [from, to, weight] : partitions[p]) {
+					sum += static_cast<double>(from.size() + to.size()) * weight;
+				}
+				sums[p] = sum;
+			});
+			benchmark::DoNotOptimize(sums);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.num_edges()));
+	}
+	BENCHMARK(bm_partitioned_for_each)->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
+} // namespace
@@ -0,0 +1,222 @@
+#include "gdwg/graph.hpp"
+#include "random_graph.hpp"
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	using benchmark_util::graph_shapes;
+	using benchmark_util::make_random_graph;
+	using benchmark_util::make_value;
+
+	// The destructive benchmarks work on a copy of the original graph and refresh it, outside the
+	// timed region, once every node or edge they target has been used up.
+	template<typename N, typename E>
+	class graph_pool {
+	public:
+		explicit graph_pool(benchmark::State const& state)
+		: original_{make_random_graph<N, E>(static_cast<int>(state.range(0)),
+		                                    static_cast<int>(state.range(1)))}
+		, graph_{original_} {}
+
+		auto original() const -> gdwg::graph<N, E> const& {
+			return original_;
+		}
+
+		auto get() -> gdwg::graph<N, E>& {
+			return graph_;
+		}
+
+		auto refresh(benchmark::State& state) -> void {
+			state.PauseTiming();
+			graph_ = original_;
+			state.ResumeTiming();
+		}
+
+	private:
+		gdwg::graph<N, E> original_;
+		gdwg::graph<N, E> graph_;
+	};
+
+	template<typename N, typename E>
+	void bm_insert_node(benchmark::State& state) {
+		auto pool = graph_pool<N, E>(state);
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto next = num_nodes;
+		for (auto _ : state) {
+			if (next == 2 * num_nodes) {
+				pool.refresh(state);
+				next = num_nodes;
+			}
+			benchmark::DoNotOptimize(pool.get().insert_node(make_value<N>(next++)));
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_insert_node, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_insert_node, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_insert_edge(benchmark::State& state) {
+		auto pool = graph_pool<N, E>(state);
+		auto const num_nodes = static_cast<int>(state.range(0));
+		// Weights above the generator's range, so every insertion adds a new edge.
+		auto weight = 1000;
+		auto src = 0;
+		for (auto _ : state) {
+			if (src == num_nodes) {
+				pool.refresh(state);
+				src = 0;
+			}
+			benchmark::DoNotOptimize(pool.get().insert_edge(make_value<N>(src),
+			                                                make_value<N>((src * 7) % num_nodes),
+			                                                make_value<E>(weight++)));
+			++src;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_insert_edge, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_insert_edge, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_replace_node(benchmark::State& state) {
+		auto pool = graph_pool<N, E>(state);
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto old_data = 0;
+		for (auto _ : state) {
+			if (old_data == num_nodes) {
+				pool.refresh(state);
+				old_data = 0;
+			}
+			benchmark::DoNotOptimize(
+			   pool.get().replace_node(make_value<N>(old_data), make_value<N>(old_data + num_nodes)));
+			++old_data;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_replace_node, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_replace_node, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_merge_replace_node(benchmark::State& state) {
+		auto pool = graph_pool<N, E>(state);
+		auto const num_nodes = static_cast<int>(state.range(0));
+		// Merges node i into node i + 1, so the surviving node's edge count keeps growing.
+		auto old_data = 0;
+		for (auto _ : state) {
+			if (old_data == num_nodes - 1) {
+				pool.refresh(state);
+				old_data = 0;
+			}
+			pool.get().merge_replace_node(make_value<N>(old_data), make_value<N>(old_data + 1));
+			++old_data;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_merge_replace_node, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_merge_replace_node, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_erase_node(benchmark::State& state) {
+		auto pool = graph_pool<N, E>(state);
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto value = 0;
+		for (auto _ : state) {
+			if (value == num_nodes) {
+				pool.refresh(state);
+				value = 0;
+			}
+			benchmark::DoNotOptimize(pool.get().erase_node(make_value<N>(value++)));
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_erase_node, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_erase_node, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_erase_edge_by_value(benchmark::State& state) {
+		auto pool = graph_pool<N, E>(state);
+		auto const edges = std::vector<typename gdwg::graph<N, E>::value_type>(pool.original().begin(),
+		                                                                        pool.original().end());
+		auto next = edges.begin();
+		for (auto _ : state) {
+			if (next == edges.end()) {
+				pool.refresh(state);
+				next = edges.begin();
+			}
+			benchmark::DoNotOptimize(pool.get().erase_edge(next->from, next->to, next->weight));
+			++next;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_erase_edge_by_value, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_erase_edge_by_value, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_erase_edge_by_iterator(benchmark::State& state) {
+		auto pool = graph_pool<N, E>(state);
+		for (auto _ : state) {
+			if (pool.get().begin() == pool.get().end()) {
+				pool.refresh(state);
+			}
+			benchmark::DoNotOptimize(pool.get().erase_edge(pool.get().begin()));
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_erase_edge_by_iterator, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_erase_edge_by_iterator, std::string, double)->Apply(graph_shapes);
+
+	// A feed of deletions naming every edge of the graph, in no particular order.
+	template<typename N, typename E>
+	auto make_erase_feed(gdwg::graph<N, E> const& g)
+	   -> std::vector<typename gdwg::graph<N, E>::value_type> {
+		auto feed = std::vector<typename gdwg::graph<N, E>::value_type>(g.begin(), g.end());
+		std::shuffle(feed.begin(), feed.end(), std::mt19937{1201});
+		return feed;
+	}
+
+	template<typename N, typename E>
+	void bm_erase_feed_by_erase_edge(benchmark::State& state) {
+		auto pool = graph_pool<N, E>(state);
+		auto const feed = make_erase_feed(pool.original());
+		for (auto _ : state) {
+			pool.refresh(state);
+			for (auto const& e : feed) {
+				pool.get().erase_edge(e.from, e.to, e.weight);
+			}
+		}
+		state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * feed.size()));
+	}
+	BENCHMARK_TEMPLATE(bm_erase_feed_by_erase_edge, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_erase_feed_by_erase_edge, std::string, double)->Apply(graph_shapes);
+
+	template<typename N, typename E>
+	void bm_erase_feed_by_erase_edges(benchmark::State& state) {
+		auto pool = graph_pool<N, E>(state);
+		auto const feed = make_erase_feed(pool.original());
+		for (auto _ : state) {
+			pool.refresh(state);
+			benchmark::DoNotOptimize(pool.get().erase_edges(feed.begin(), feed.end()));
+		}
+		state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * feed.size()));
+	}
+	BENCHMARK_TEMPLATE(bm_erase_feed_by_erase_edges, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_erase_feed_by_erase_edges, std::string, double)->Apply(graph_shapes);
+
+	// Erases one node's worth of edges per iteration.
+	template<typename N, typename E>
+	void bm_erase_edge_range(benchmark::State& state) {
+		auto pool = graph_pool<N, E>(state);
+		auto const degree = state.range(1);
+		for (auto _ : state) {
+			if (pool.get().begin() == pool.get().end()) {
+				pool.refresh(state);
+			}
+			auto& g = pool.get();
+			auto last = g.begin();
+			for (auto i = 0; i < degree and last != g.end(); ++i) {
+				++last;
+			}
+			benchmark::DoNotOptimize(g.erase_edge(g.begin(), last));
+		}
+		state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * degree);
+	}
+	BENCHMARK_TEMPLATE(bm_erase_edge_range, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_erase_edge_range, std::string, double)->Apply(graph_shapes);
+} // namespace
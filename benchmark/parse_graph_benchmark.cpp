@@ -0,0 +1,69 @@
+#include "gdwg/parse_graph.hpp"
+#include "random_graph.hpp"
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	using benchmark_util::make_random_graph;
+
+	auto adjacency_text(int num_nodes) -> std::string {
+		auto out = std::ostringstream{};
+		out << make_random_graph(num_nodes);
+		return out.str();
+	}
+
+	auto edge_list_text(int num_nodes) -> std::string {
+		auto out = std::ostringstream{};
+		for (auto const& [from, to, weight] : make_random_graph(num_nodes)) {
+			out << from << ' ' << to << ' ' << weight << '\n';
+		}
+		return out.str();
+	}
+
+	void bm_parse_adjacency(benchmark::State& state) {
+		auto const text = adjacency_text(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			auto in = std::istringstream(text);
+			benchmark::DoNotOptimize(gdwg::parse_graph<int, int>(in));
+		}
+		state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * text.size()));
+	}
+	BENCHMARK(bm_parse_adjacency)->RangeMultiplier(8)->Range(1 << 8, 1 << 17);
+
+	void bm_parse_edge_list(benchmark::State& state) {
+		auto const text = edge_list_text(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			auto in = std::istringstream(text);
+			benchmark::DoNotOptimize(gdwg::parse_graph<int, int>(in, gdwg::graph_format::edge_list));
+		}
+		state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * text.size()));
+	}
+	BENCHMARK(bm_parse_edge_list)->RangeMultiplier(8)->Range(1 << 8, 1 << 17);
+
+	// The straightforward reader, for comparison: std::getline and an istringstream per line, one
+	// insert_edge per edge.
+	void bm_parse_edge_list_getline(benchmark::State& state) {
+		auto const text = edge_list_text(static_cast<int>(state.range(0)));
+		for (auto _ : state) {
+			auto in = std::istringstream(text);
+			auto g = gdwg::graph<int, int>{};
+			for (auto line = std::string(); std::getline(in, line);) {
+				auto fields = std::istringstream(line);
+				auto from = 0;
+				auto to = 0;
+				auto weight = 0;
+				fields >> from >> to >> weight;
+				g.insert_node(from);
+				g.insert_node(to);
+				g.insert_edge(from, to, weight);
+			}
+			benchmark::DoNotOptimize(g);
+		}
+		state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * text.size()));
+	}
+	BENCHMARK(bm_parse_edge_list_getline)->RangeMultiplier(8)->Range(1 << 8, 1 << 17);
+} // namespace
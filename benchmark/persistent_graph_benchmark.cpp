@@ -0,0 +1,70 @@
+#include "gdwg/persistent_graph.hpp"
+#include "random_graph.hpp"
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+namespace {
+	using benchmark_util::graph_shapes;
+	using benchmark_util::make_random_graph;
+
+	constexpr auto batch_size = 8;
+
+	// The speculative-edit workflow: keep the current version, then apply a small batch of edits
+	// to a copy of it. graph pays O(n + e) for the copy; persistent_graph pays for the edits.
+	template<typename Graph>
+	void bm_copy_and_edit(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = Graph(make_random_graph(num_nodes, static_cast<int>(state.range(1))));
+		auto src = 0;
+		for (auto _ : state) {
+			auto version = g;
+			for (auto i = 0; i < batch_size; ++i) {
+				version.insert_edge(src, (src * 7) % num_nodes, -1);
+				src = (src + 1) % num_nodes;
+			}
+			benchmark::DoNotOptimize(version);
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_copy_and_edit, gdwg::graph<int, int>)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_copy_and_edit, gdwg::persistent_graph<int, int>)->Apply(graph_shapes);
+
+	// Many versions alive at once, each one batch of edits past the one before.
+	template<typename Graph>
+	void bm_keep_versions(benchmark::State& state) {
+		auto const num_nodes = 1 << 11;
+		auto const g = Graph(make_random_graph(num_nodes));
+		for (auto _ : state) {
+			auto versions = std::vector<Graph>{g};
+			versions.reserve(static_cast<std::size_t>(state.range(0)) + 1);
+			for (auto v = 0; v < state.range(0); ++v) {
+				auto version = versions.back();
+				for (auto i = 0; i < batch_size; ++i) {
+					auto const src = (v * batch_size + i) % num_nodes;
+					version.insert_edge(src, (src * 7) % num_nodes, -1);
+				}
+				versions.push_back(std::move(version));
+			}
+			benchmark::DoNotOptimize(versions);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK_TEMPLATE(bm_keep_versions, gdwg::graph<int, int>)->Arg(1 << 6)->Arg(1 << 10);
+	BENCHMARK_TEMPLATE(bm_keep_versions, gdwg::persistent_graph<int, int>)
+	   ->Arg(1 << 6)
+	   ->Arg(1 << 10);
+
+	// What the sharing costs on reads.
+	template<typename Graph>
+	void bm_weights(benchmark::State& state) {
+		auto const num_nodes = static_cast<int>(state.range(0));
+		auto const g = Graph(make_random_graph(num_nodes, static_cast<int>(state.range(1))));
+		auto src = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(g.weights(src, (src * 7) % num_nodes));
+			src = (src + 1) % num_nodes;
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_weights, gdwg::graph<int, int>)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_weights, gdwg::persistent_graph<int, int>)->Apply(graph_shapes);
+} // namespace
@@ -0,0 +1,65 @@
+#ifndef GDWG_BENCHMARK_RANDOM_GRAPH_HPP
+#define GDWG_BENCHMARK_RANDOM_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace benchmark_util {
+	constexpr auto average_degree = 16;
+
+	// The i-th distinct node value or edge weight of type T.
+	template<typename T>
+	auto make_value(int i) -> T;
+
+	template<>
+	inline auto make_value<int>(int i) -> int {
+		return i;
+	}
+
+	template<>
+	inline auto make_value<double>(int i) -> double {
+		return static_cast<double>(i) / 4;
+	}
+
+	template<>
+	inline auto make_value<std::string>(int i) -> std::string {
+		return "node " + std::to_string(i);
+	}
+
+	// Random graph with `num_nodes` nodes and `degree` out-edges per node.
+	template<typename N = int, typename E = int, typename Index = gdwg::ordered_index>
+	auto make_random_graph(int num_nodes, int degree = average_degree)
+	   -> gdwg::graph<N, E, std::allocator<std::byte>, Index> {
+		auto g = gdwg::graph<N, E, std::allocator<std::byte>, Index>{};
+		for (auto i = 0; i < num_nodes; ++i) {
+			g.insert_node(make_value<N>(i));
+		}
+		auto rng = std::mt19937{6771};
+		auto node = std::uniform_int_distribution<int>{0, num_nodes - 1};
+		auto weight = std::uniform_int_distribution<int>{0, 100};
+		for (auto src = 0; src < num_nodes; ++src) {
+			for (auto i = 0; i < degree; ++i) {
+				g.insert_edge(make_value<N>(src), make_value<N>(node(rng)), make_value<E>(weight(rng)));
+			}
+		}
+		return g;
+	}
+
+	// Registers the (nodes, degree) grid shared by the graph benchmarks: sparse and dense graphs
+	// at three sizes.
+	inline void graph_shapes(benchmark::internal::Benchmark* b) {
+		b->ArgNames({"nodes", "degree"});
+		for (auto nodes : {1 << 8, 1 << 11, 1 << 14}) {
+			for (auto degree : {2, 16}) {
+				b->Args({nodes, degree});
+			}
+		}
+	}
+} // namespace benchmark_util
+
+#endif // GDWG_BENCHMARK_RANDOM_GRAPH_HPP
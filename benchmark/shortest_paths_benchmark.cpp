@@ -0,0 +1,77 @@
+#include "gdwg/shortest_paths.hpp"
+#include "random_graph.hpp"
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <map>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+	using benchmark_util::graph_shapes;
+	using benchmark_util::make_random_graph;
+	using benchmark_util::make_value;
+
+	// Dijkstra written against the public graph API, for comparison: every relaxation looks its
+	// nodes up by value, and distances live in a std::map.
+	template<typename N, typename E>
+	auto dijkstra_by_value(gdwg::graph<N, E> const& g, N const& src) -> std::map<N, E> {
+		auto distance = std::map<N, E>{{src, E{}}};
+		using entry = std::pair<E, N>;
+		auto queue = std::priority_queue<entry, std::vector<entry>, std::greater<>>{};
+		queue.emplace(E{}, src);
+		while (not queue.empty()) {
+			auto [d, from] = queue.top();
+			queue.pop();
+			if (distance[from] < d) {
+				continue;
+			}
+			for (auto const& to : g.connections(from)) {
+				auto const candidate = d + g.weights(from, to).front();
+				auto [itor, inserted] = distance.try_emplace(to, candidate);
+				if (inserted or candidate < itor->second) {
+					itor->second = candidate;
+					queue.emplace(candidate, to);
+				}
+			}
+		}
+		return distance;
+	}
+
+	template<typename N, typename E>
+	void bm_dijkstra_by_value(benchmark::State& state) {
+		auto const g = make_random_graph<N, E>(static_cast<int>(state.range(0)),
+		                                       static_cast<int>(state.range(1)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(dijkstra_by_value(g, make_value<N>(0)));
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_dijkstra_by_value, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_dijkstra_by_value, std::string, double)->Apply(graph_shapes);
+
+	// Including the snapshot of the graph.
+	template<typename N, typename E>
+	void bm_shortest_paths(benchmark::State& state) {
+		auto const g = make_random_graph<N, E>(static_cast<int>(state.range(0)),
+		                                       static_cast<int>(state.range(1)));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::shortest_paths(g, make_value<N>(0)));
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_shortest_paths, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_shortest_paths, std::string, double)->Apply(graph_shapes);
+
+	// Repeated queries against one snapshot.
+	template<typename N, typename E>
+	void bm_shortest_paths_snapshot(benchmark::State& state) {
+		auto const g = gdwg::csr_graph(make_random_graph<N, E>(static_cast<int>(state.range(0)),
+		                                                       static_cast<int>(state.range(1))));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::shortest_paths(g, make_value<N>(0)));
+		}
+	}
+	BENCHMARK_TEMPLATE(bm_shortest_paths_snapshot, int, int)->Apply(graph_shapes);
+	BENCHMARK_TEMPLATE(bm_shortest_paths_snapshot, std::string, double)->Apply(graph_shapes);
+} // namespace
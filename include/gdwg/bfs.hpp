@@ -0,0 +1,284 @@
+#ifndef GDWG_BFS_HPP
+#define GDWG_BFS_HPP
+
+#include <gdwg/csr_graph.hpp>
+#include <gdwg/graph.hpp>
+#include <gdwg/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Multi-hop reachability. Both entry points run a level-synchronous breadth-first search over a
+// CSR snapshot's dense node indices, switching each level between top-down (expand the frontier's
+// out-edges) and bottom-up (have every unvisited node look for a parent in the frontier) as in
+// Beamer et al., "Direction-Optimizing Breadth-First Search", with each level split across a
+// thread pool.
+namespace gdwg {
+	namespace detail {
+		// Runs the search from source and returns every node's depth, or unreached.
+		template<typename N, typename E>
+		class bfs {
+		public:
+			static constexpr auto unreached = std::numeric_limits<std::size_t>::max();
+
+			bfs(csr_graph<N, E> const& g, thread_pool& pool)
+			: g_{g}
+			, pool_{pool}
+			, depths_(g.num_nodes(), unreached)
+			, visited_((g.num_nodes() + 63) / 64) {}
+
+			auto run(std::size_t source) -> std::vector<std::size_t> {
+				auto queue = std::vector<std::size_t>{source};
+				auto frontier = std::vector<std::uint64_t>();
+				auto frontier_size = std::size_t{1};
+				auto frontier_edges = g_.out_targets(source).size();
+				auto unexplored_edges = g_.num_edges() - frontier_edges;
+				auto bottom_up = false;
+				depths_[source] = 0;
+				visited_[source / 64] |= bit(source);
+				for (auto depth = std::size_t{1}; frontier_size != 0; ++depth) {
+					if (not bottom_up and frontier_edges > unexplored_edges / alpha) {
+						frontier = to_bitmap(queue);
+						bottom_up = true;
+					}
+					else if (bottom_up and frontier_size < g_.num_nodes() / beta) {
+						queue = to_queue(frontier);
+						bottom_up = false;
+					};
+					auto const [size, edges] = bottom_up ? step_bottom_up(frontier, depth)
+					                                     : step_top_down(queue, depth);
+					frontier_size = size;
+					frontier_edges = edges;
+					unexplored_edges -= edges;
+				};
+				return std::move(depths_);
+			};
+
+		private:
+			// Beamer et al.'s tuning: go bottom-up once the frontier has more than 1/alpha of the
+			// unexplored edges, and back once it holds fewer than 1/beta of the nodes.
+			static constexpr auto alpha = std::size_t{14};
+			static constexpr auto beta = std::size_t{24};
+			// Nodes per task top-down, bitmap words (of 64 nodes) per task bottom-up.
+			static constexpr auto queue_grain = std::size_t{1024};
+			static constexpr auto word_grain = std::size_t{64};
+
+			struct level {
+				std::size_t size = 0;
+				std::size_t edges = 0;
+			};
+
+			csr_graph<N, E> const& g_;
+			thread_pool& pool_;
+			std::vector<std::size_t> depths_;
+			std::vector<std::uint64_t> visited_;
+
+			static auto bit(std::size_t index) -> std::uint64_t {
+				return std::uint64_t{1} << (index % 64);
+			};
+
+			// Expands the queued frontier, claiming each newly seen node with an atomic OR so that
+			// exactly one task queues it. Replaces queue with the next frontier.
+			auto step_top_down(std::vector<std::size_t>& queue, std::size_t depth) -> level {
+				auto const tasks = (queue.size() + queue_grain - 1) / queue_grain;
+				auto found = std::vector<std::vector<std::size_t>>(tasks);
+				auto levels = std::vector<level>(tasks);
+				pool_.run(tasks, [&](std::size_t task) {
+					auto const first = task * queue_grain;
+					auto const last = std::min(first + queue_grain, queue.size());
+					for (auto i = first; i < last; ++i) {
+						for (auto const to : g_.out_targets(queue[i])) {
+							auto word = std::atomic_ref<std::uint64_t>(visited_[to / 64]);
+							if ((word.load(std::memory_order_relaxed) & bit(to)) != 0
+							    or (word.fetch_or(bit(to), std::memory_order_relaxed) & bit(to)) != 0)
+							{
+								continue;
+							};
+							depths_[to] = depth;
+							found[task].push_back(to);
+							levels[task].edges += g_.out_targets(to).size();
+						};
+					};
+					levels[task].size = found[task].size();
+				});
+				queue.clear();
+				auto next = level{};
+				for (auto task = std::size_t{0}; task < tasks; ++task) {
+					queue.insert(queue.end(), found[task].begin(), found[task].end());
+					next.size += levels[task].size;
+					next.edges += levels[task].edges;
+				};
+				return next;
+			};
+
+			// Checks every unvisited node for an in-neighbour in the frontier bitmap. Each task owns
+			// a run of whole bitmap words, so it updates visited_ and the next frontier without
+			// atomics. Replaces frontier with the next one.
+			auto step_bottom_up(std::vector<std::uint64_t>& frontier, std::size_t depth) -> level {
+				auto next = std::vector<std::uint64_t>(visited_.size());
+				auto const tasks = (visited_.size() + word_grain - 1) / word_grain;
+				auto levels = std::vector<level>(tasks);
+				pool_.run(tasks, [&](std::size_t task) {
+					auto const first = task * word_grain;
+					auto const last = std::min(first + word_grain, visited_.size());
+					for (auto w = first; w < last; ++w) {
+						for (auto unvisited = ~visited_[w] & valid_bits(w); unvisited != 0;
+						     unvisited &= unvisited - 1) {
+							auto const to = w * 64 + static_cast<std::size_t>(std::countr_zero(unvisited));
+							for (auto const from : g_.in_sources(to)) {
+								if ((frontier[from / 64] & bit(from)) != 0) {
+									depths_[to] = depth;
+									next[w] |= bit(to);
+									++levels[task].size;
+									levels[task].edges += g_.out_targets(to).size();
+									break;
+								};
+							};
+						};
+						visited_[w] |= next[w];
+					};
+				});
+				frontier = std::move(next);
+				return std::accumulate(levels.begin(), levels.end(), level{}, [](level a, level b) {
+					return level{a.size + b.size, a.edges + b.edges};
+				});
+			};
+
+			// Bits of word w that stand for nodes.
+			auto valid_bits(std::size_t w) const -> std::uint64_t {
+				auto const remaining = g_.num_nodes() - w * 64;
+				return remaining >= 64 ? ~std::uint64_t{0} : bit(remaining) - 1;
+			};
+
+			auto to_bitmap(std::vector<std::size_t> const& queue) const -> std::vector<std::uint64_t> {
+				auto bitmap = std::vector<std::uint64_t>(visited_.size());
+				for (auto const index : queue) {
+					bitmap[index / 64] |= bit(index);
+				};
+				return bitmap;
+			};
+
+			static auto to_queue(std::vector<std::uint64_t> const& bitmap)
+			   -> std::vector<std::size_t> {
+				auto queue = std::vector<std::size_t>();
+				for (auto w = std::size_t{0}; w < bitmap.size(); ++w) {
+					for (auto bits = bitmap[w]; bits != 0; bits &= bits - 1) {
+						queue.push_back(w * 64 + static_cast<std::size_t>(std::countr_zero(bits)));
+					};
+				};
+				return queue;
+			};
+		};
+
+		template<typename N, typename E>
+		auto bfs_depths(csr_graph<N, E> const& g,
+		                N const& src,
+		                thread_pool& pool,
+		                char const* caller) -> std::vector<std::size_t> {
+			auto const source = g.node_index(src);
+			if (not source) {
+				throw std::runtime_error(std::string("Cannot call gdwg::") + caller
+				                         + " if src doesn't exist in the graph");
+			};
+			return bfs<N, E>(g, pool).run(*source);
+		};
+	} // namespace detail
+
+	// The nodes reachable from src (src included), sorted. The search runs on pool, which can be
+	// kept and passed to every search so that its threads are started only once.
+	template<typename N, typename E>
+	auto reachable(csr_graph<N, E> const& g, std::type_identity_t<N> const& src, thread_pool& pool)
+	   -> std::vector<N> {
+		auto const depths = detail::bfs_depths(g, src, pool, "reachable");
+		auto nodes = std::vector<N>();
+		for (auto i = std::size_t{0}; i < depths.size(); ++i) {
+			if (depths[i] != detail::bfs<N, E>::unreached) {
+				nodes.push_back(g.node(i));
+			};
+		};
+		return nodes;
+	};
+
+	// As above, on a pool of its own: threads is the number of threads to search with, and zero
+	// means one per hardware thread.
+	template<typename N, typename E>
+	auto reachable(csr_graph<N, E> const& g,
+	               std::type_identity_t<N> const& src,
+	               std::size_t threads = 0) -> std::vector<N> {
+		auto pool = thread_pool(threads);
+		return reachable(g, src, pool);
+	};
+
+	// The nodes reachable from src grouped by their distance from it in edges: levels[0] is {src},
+	// levels[k] the nodes k hops away. Each level is sorted. The search runs on pool.
+	template<typename N, typename E>
+	auto bfs_levels(csr_graph<N, E> const& g, std::type_identity_t<N> const& src, thread_pool& pool)
+	   -> std::vector<std::vector<N>> {
+		auto const depths = detail::bfs_depths(g, src, pool, "bfs_levels");
+		auto levels = std::vector<std::vector<N>>();
+		for (auto i = std::size_t{0}; i < depths.size(); ++i) {
+			if (depths[i] == detail::bfs<N, E>::unreached) {
+				continue;
+			};
+			if (depths[i] >= levels.size()) {
+				levels.resize(depths[i] + 1);
+			};
+			levels[depths[i]].push_back(g.node(i));
+		};
+		return levels;
+	};
+
+	template<typename N, typename E>
+	auto bfs_levels(csr_graph<N, E> const& g,
+	                std::type_identity_t<N> const& src,
+	                std::size_t threads = 0) -> std::vector<std::vector<N>> {
+		auto pool = thread_pool(threads);
+		return bfs_levels(g, src, pool);
+	};
+
+	template<typename N, typename E, typename Alloc, typename Index>
+	auto reachable(graph<N, E, Alloc, Index> const& g,
+	               std::type_identity_t<N> const& src,
+	               thread_pool& pool) -> std::vector<N> {
+		if (not g.is_node(src)) {
+			throw std::runtime_error("Cannot call gdwg::reachable if src doesn't exist in the graph");
+		};
+		return reachable(csr_graph(g), src, pool);
+	};
+
+	template<typename N, typename E, typename Alloc, typename Index>
+	auto reachable(graph<N, E, Alloc, Index> const& g,
+	               std::type_identity_t<N> const& src,
+	               std::size_t threads = 0) -> std::vector<N> {
+		auto pool = thread_pool(threads);
+		return reachable(g, src, pool);
+	};
+
+	template<typename N, typename E, typename Alloc, typename Index>
+	auto bfs_levels(graph<N, E, Alloc, Index> const& g,
+	                std::type_identity_t<N> const& src,
+	                thread_pool& pool) -> std::vector<std::vector<N>> {
+		if (not g.is_node(src)) {
+			throw std::runtime_error("Cannot call gdwg::bfs_levels if src doesn't exist in the graph");
+		};
+		return bfs_levels(csr_graph(g), src, pool);
+	};
+
+	template<typename N, typename E, typename Alloc, typename Index>
+	auto bfs_levels(graph<N, E, Alloc, Index> const& g,
+	                std::type_identity_t<N> const& src,
+	                std::size_t threads = 0) -> std::vector<std::vector<N>> {
+		auto pool = thread_pool(threads);
+		return bfs_levels(g, src, pool);
+	};
+} // namespace gdwg
+#endif // GDWG_BFS_HPP
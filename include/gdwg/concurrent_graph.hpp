@@ -0,0 +1,228 @@
+#ifndef GDWG_CONCURRENT_GRAPH_HPP
+#define GDWG_CONCURRENT_GRAPH_HPP
+
+#include <gdwg/graph.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		// Count of readers inside one version of a left-right structure, split over cache lines
+		// so that readers on different threads rarely touch the same one.
+		class read_indicator {
+		public:
+			auto arrive() noexcept -> std::size_t {
+				auto const slot = this_thread_stripe();
+				stripes_[slot].count.fetch_add(1);
+				return slot;
+			};
+
+			auto depart(std::size_t slot) noexcept -> void {
+				stripes_[slot].count.fetch_sub(1);
+			};
+
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				for (auto const& s : stripes_) {
+					if (s.count.load() != 0) {
+						return false;
+					};
+				};
+				return true;
+			};
+
+		private:
+			static constexpr auto num_stripes = std::size_t{32};
+
+			struct alignas(64) stripe {
+				std::atomic<std::ptrdiff_t> count = 0;
+			};
+
+			std::array<stripe, num_stripes> stripes_;
+
+			static auto this_thread_stripe() noexcept -> std::size_t {
+				thread_local auto const slot =
+				   std::hash<std::thread::id>{}(std::this_thread::get_id()) % num_stripes;
+				return slot;
+			};
+		};
+	} // namespace detail
+
+	// A graph that any number of threads can read while one thread at a time writes. Readers
+	// never block and never wait for writers.
+	//
+	// This is the left-right technique (Ramalhete and Correia). Two copies of the graph are kept
+	// in step. Readers go to whichever copy is current, after announcing themselves on a striped
+	// counter. A writer applies its change to the other copy, makes that copy current, waits for
+	// the readers still on the old copy to leave, and then applies the same change to it. Reads
+	// cost two atomic increments on top of the plain graph call. Writes cost twice the plain call
+	// plus the wait for in-flight readers, and the graph is stored twice.
+	//
+	// Nothing a reader gets refers back into the graph, so results stay valid across writes.
+	template<typename N, typename E>
+	class concurrent_graph {
+	public:
+		using graph_type = graph<N, E>;
+		using value_type = typename graph_type::value_type;
+
+		concurrent_graph() = default;
+
+		explicit concurrent_graph(graph_type const& g)
+		: graphs_{g, g} {}
+
+		concurrent_graph(concurrent_graph const&) = delete;
+		auto operator=(concurrent_graph const&) -> concurrent_graph& = delete;
+
+		// Reads: each one sees the graph as it was before or after any given write, never during.
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return read([&](graph_type const& g) { return g.is_node(value); });
+		};
+
+		[[nodiscard]] auto is_connected(N const& src, N const& dest) const -> bool {
+			return read([&](graph_type const& g) { return g.is_connected(src, dest); });
+		};
+
+		[[nodiscard]] auto weights(N const& src, N const& dest) const -> std::vector<E> {
+			return read([&](graph_type const& g) { return g.weights(src, dest); });
+		};
+
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			return read([&](graph_type const& g) { return g.connections(src); });
+		};
+
+		// The edge, copied out of the graph, or nullopt if there is no such edge.
+		[[nodiscard]] auto find(N const& src, N const& dest, E const& weight) const
+		   -> std::optional<value_type> {
+			return read([&](graph_type const& g) -> std::optional<value_type> {
+				auto itor = g.find(src, dest, weight);
+				return itor == g.end() ? std::nullopt : std::optional<value_type>(*itor);
+			});
+		};
+
+		[[nodiscard]] auto snapshot() const -> graph_type {
+			return read([](graph_type const& g) { return g; });
+		};
+
+		// Calls f with the current graph, which no write changes until f returns, and returns
+		// what f returns. f must not keep references into the graph.
+		template<typename F>
+		auto read(F&& f) const -> std::invoke_result_t<F&, graph_type const&> {
+			auto& readers = readers_[version_.load()];
+			auto const slot = readers.arrive();
+			auto const guard = departure(readers, slot);
+			return std::invoke(f, graphs_[current_.load()]);
+		};
+
+		// Writes. Writers are serialised among themselves.
+		auto insert_node(N const& value) -> bool {
+			return write([&](graph_type& g) { return g.insert_node(value); });
+		};
+
+		auto insert_edge(N const& src, N const& dest, E const& weight) -> bool {
+			return write([&](graph_type& g) { return g.insert_edge(src, dest, weight); });
+		};
+
+		auto replace_node(N const& old_data, N const& new_data) -> bool {
+			return write([&](graph_type& g) { return g.replace_node(old_data, new_data); });
+		};
+
+		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
+			write([&](graph_type& g) { g.merge_replace_node(old_data, new_data); });
+		};
+
+		auto erase_node(N const& value) -> bool {
+			return write([&](graph_type& g) { return g.erase_node(value); });
+		};
+
+		auto erase_edge(N const& src, N const& dest, E const& weight) -> bool {
+			return write([&](graph_type& g) { return g.erase_edge(src, dest, weight); });
+		};
+
+		auto clear() -> void {
+			write([](graph_type& g) { g.clear(); });
+		};
+
+		// Applies f to both copies of the graph, one after the other, and returns what the first
+		// call returned. f must therefore do the same thing both times: it may only depend on its
+		// arguments and the graph. If the first call throws, the copy it ran on is overwritten with
+		// the published one, so the write changes nothing, and f is not called again. If the second
+		// call throws, that copy is overwritten with the already-published result instead.
+		template<typename F>
+		auto write(F&& f) -> std::invoke_result_t<F&, graph_type&> {
+			auto const lock = std::scoped_lock(writer_);
+			auto const current = current_.load(std::memory_order_relaxed);
+			if constexpr (std::is_void_v<std::invoke_result_t<F&, graph_type&>>) {
+				apply(f, 1 - current);
+				publish(1 - current);
+				apply(f, current);
+			}
+			else {
+				auto result = apply(f, 1 - current);
+				publish(1 - current);
+				apply(f, current);
+				return result;
+			};
+		};
+
+	private:
+		struct departure {
+			detail::read_indicator& readers;
+			std::size_t stripe;
+
+			departure(detail::read_indicator& indicator, std::size_t slot)
+			: readers{indicator}
+			, stripe{slot} {};
+			departure(departure const&) = delete;
+			auto operator=(departure const&) -> departure& = delete;
+			~departure() {
+				readers.depart(stripe);
+			};
+		};
+
+		std::array<graph_type, 2> graphs_;
+		// The copy new readers go to.
+		std::atomic<std::size_t> current_ = 0;
+		// Which of readers_ new readers announce themselves on.
+		std::atomic<std::size_t> version_ = 0;
+		mutable std::array<detail::read_indicator, 2> readers_;
+		std::mutex writer_;
+
+		// Calls f on graphs_[target], which no reader can see. If f throws partway through a change,
+		// the copies would diverge, so graphs_[target] is copied back from the other one first.
+		template<typename F>
+		auto apply(F& f, std::size_t target) -> std::invoke_result_t<F&, graph_type&> {
+			try {
+				return std::invoke(f, graphs_[target]);
+			} catch (...) {
+				graphs_[target] = graphs_[1 - target];
+				throw;
+			};
+		};
+
+		// Sends new readers to graphs_[next] and waits until no reader can still be using the
+		// other copy. Readers that arrive meanwhile may have read current_ before the switch, so
+		// the wait flips version_ between two drained indicators rather than draining just one.
+		auto publish(std::size_t next) -> void {
+			current_.store(next);
+			auto const version = version_.load();
+			wait_until_empty(readers_[1 - version]);
+			version_.store(1 - version);
+			wait_until_empty(readers_[version]);
+		};
+
+		static auto wait_until_empty(detail::read_indicator const& readers) -> void {
+			while (not readers.empty()) {
+				std::this_thread::yield();
+			};
+		};
+	};
+} // namespace gdwg
+#endif // GDWG_CONCURRENT_GRAPH_HPP
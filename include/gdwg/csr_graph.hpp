@@ -0,0 +1,542 @@
+#ifndef GDWG_CSR_GRAPH_HPP
+#define GDWG_CSR_GRAPH_HPP
+
+#include <gdwg/graph.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <compare>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Read-only snapshot of a gdwg::graph in Compressed Sparse Row form. Nodes are stored sorted in a
+// contiguous array; the out-edges of node i occupy [offsets_[i], offsets_[i + 1]) of the parallel
+// targets_/weights_ arrays, sorted by (destination, weight), so every lookup is a binary search
+// over contiguous memory.
+//
+// The arrays are views into immutable storage shared between copies: either vectors built from a
+// graph, or a read-only memory mapping of a file written by write_binary (see map_binary).
+//
+// Because the edges are contiguous, iterators are random access: an edge range can be split into
+// even parts in O(log n), for instance by the parallel standard algorithms.
+namespace gdwg {
+	template<typename N, typename E>
+	class csr_graph {
+	public:
+		using value_type = typename graph<N, E>::value_type;
+		using reference = typename graph<N, E>::reference;
+		using size_type = std::size_t;
+
+		// Constructors
+		csr_graph() = default;
+
+		template<typename Alloc, typename Index>
+		explicit csr_graph(graph<N, E, Alloc, Index> const& g) {
+			using node = typename graph<N, E, Alloc, Index>::node;
+			auto storage = std::make_shared<arrays>();
+			auto index = std::unordered_map<node const*, size_type>{};
+			index.reserve(g.nodes_.size());
+			storage->nodes.reserve(g.nodes_.size());
+			std::for_each(g.nodes_.begin(), g.nodes_.end(), [&](node const& n) {
+				index.emplace(&n, storage->nodes.size());
+				storage->nodes.push_back(n.value);
+			});
+
+			storage->offsets.assign(storage->nodes.size() + 1, 0);
+			storage->targets.reserve(g.edges_.size());
+			storage->weights.reserve(g.edges_.size());
+			// edges_ is sorted by source, then destination, then weight: already CSR order.
+			std::for_each(g.edges_.begin(), g.edges_.end(), [&](auto const& e) {
+				++storage->offsets[index[e.src] + 1];
+				storage->targets.push_back(index[e.dest]);
+				storage->weights.push_back(e.weight);
+			});
+			auto& offsets = storage->offsets;
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+			nodes_ = storage->nodes;
+			offsets_ = storage->offsets;
+			targets_ = storage->targets;
+			weights_ = storage->weights;
+			storage_ = std::move(storage);
+			in_edges_ = std::make_shared<in_edge_index>();
+		};
+
+		csr_graph(csr_graph const&) = default;
+		auto operator=(csr_graph const&) -> csr_graph& = default;
+
+		// A moved-from snapshot is empty, like a default-constructed one, rather than keeping views
+		// into storage it no longer shares. Moves allocate nothing.
+		csr_graph(csr_graph&& other) noexcept {
+			swap_contents(other);
+		};
+
+		auto operator=(csr_graph&& other) noexcept -> csr_graph& {
+			auto moved = csr_graph(std::move(other));
+			swap_contents(moved);
+			return *this;
+		};
+
+		// Iterator
+		class iterator {
+		public:
+			using value_type = csr_graph<N, E>::value_type;
+			using reference = csr_graph<N, E>::reference;
+			using pointer = void;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::random_access_iterator_tag;
+
+			// Iterator constructor
+			iterator() = default;
+
+			// Iterator source
+			auto operator*() const -> reference {
+				return reference{g_->nodes_[src_], g_->nodes_[g_->targets_[pos_]], g_->weights_[pos_]};
+			};
+
+			auto operator[](difference_type n) const -> reference {
+				return *(*this + n);
+			};
+
+			// Iterator traversal
+			auto operator++() -> iterator& {
+				++pos_;
+				skip_exhausted_sources();
+				return *this;
+			};
+
+			auto operator++(int) -> iterator {
+				auto tmp = *this;
+				++(*this);
+				return tmp;
+			};
+
+			auto operator--() -> iterator& {
+				--pos_;
+				while (g_->offsets_[src_] > pos_) {
+					--src_;
+				};
+				return *this;
+			};
+
+			auto operator--(int) -> iterator {
+				auto tmp = *this;
+				--(*this);
+				return tmp;
+			};
+
+			// Jumps find the new source by binary search over the offsets.
+			auto operator+=(difference_type n) -> iterator& {
+				pos_ = static_cast<size_type>(static_cast<difference_type>(pos_) + n);
+				src_ = g_->source_of(pos_);
+				return *this;
+			};
+
+			auto operator-=(difference_type n) -> iterator& {
+				return *this += -n;
+			};
+
+			friend auto operator+(iterator itor, difference_type n) -> iterator {
+				return itor += n;
+			};
+
+			friend auto operator+(difference_type n, iterator itor) -> iterator {
+				return itor += n;
+			};
+
+			friend auto operator-(iterator itor, difference_type n) -> iterator {
+				return itor -= n;
+			};
+
+			friend auto operator-(iterator const& lhs, iterator const& rhs) -> difference_type {
+				return static_cast<difference_type>(lhs.pos_) - static_cast<difference_type>(rhs.pos_);
+			};
+
+			// Iterator comparison
+			auto operator==(iterator const& other) const -> bool {
+				return pos_ == other.pos_;
+			};
+
+			auto operator<=>(iterator const& other) const -> std::strong_ordering {
+				return pos_ <=> other.pos_;
+			};
+
+		private:
+			csr_graph const* g_ = nullptr;
+			size_type src_ = 0;
+			size_type pos_ = 0;
+
+			// src must already own pos, or be the last node if pos is past the last edge.
+			iterator(csr_graph const* g, size_type src, size_type pos)
+			: g_{g}
+			, src_{src}
+			, pos_{pos} {};
+
+			// Keeps src_ on the node owning pos_; an end iterator parks on the last node.
+			auto skip_exhausted_sources() -> void {
+				while (src_ + 1 < g_->nodes_.size() and g_->offsets_[src_ + 1] <= pos_) {
+					++src_;
+				};
+			};
+
+			friend class csr_graph<N, E>;
+		};
+
+		// Accessors
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return std::binary_search(nodes_.begin(), nodes_.end(), value);
+		};
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return nodes_.empty();
+		};
+
+		[[nodiscard]] auto is_connected(N const& src, N const& dest) const -> bool {
+			auto src_index = index_of(src);
+			auto dest_index = index_of(dest);
+			if (src_index == nodes_.size() or dest_index == nodes_.size()) {
+				throw std::runtime_error("Cannot call gdwg::csr_graph<N, E>::is_connected "
+				                         "if src or dst node don't exist in the graph");
+			};
+			auto [first, last] = targets_of(src_index, dest_index);
+			return first != last;
+		};
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			return std::vector<N>(nodes_.begin(), nodes_.end());
+		};
+
+		[[nodiscard]] auto weights(N const& src, N const& dest) const -> std::vector<E> {
+			auto src_index = index_of(src);
+			auto dest_index = index_of(dest);
+			if (src_index == nodes_.size() or dest_index == nodes_.size()) {
+				throw std::runtime_error("Cannot call gdwg::csr_graph<N, E>::weights "
+				                         "if src or dst node don't exist in the graph");
+			};
+			auto [first, last] = targets_of(src_index, dest_index);
+			return std::vector<E>(weights_.begin() + (first - targets_.begin()),
+			                      weights_.begin() + (last - targets_.begin()));
+		};
+
+		[[nodiscard]] auto find(N const& src, N const& dest, E const& weight) const -> iterator {
+			auto src_index = index_of(src);
+			auto dest_index = index_of(dest);
+			if (src_index == nodes_.size() or dest_index == nodes_.size()) {
+				return end();
+			};
+			auto [first, last] = targets_of(src_index, dest_index);
+			auto const weights_first = weights_.begin() + (first - targets_.begin());
+			auto const weights_last = weights_.begin() + (last - targets_.begin());
+			auto itor = std::lower_bound(weights_first, weights_last, weight);
+			if (itor == weights_last or weight < *itor) {
+				return end();
+			};
+			return iterator{this, src_index, static_cast<size_type>(itor - weights_.begin())};
+		};
+
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto src_index = index_of(src);
+			if (src_index == nodes_.size()) {
+				throw std::runtime_error("Cannot call gdwg::csr_graph<N, E>::connections "
+				                         "if src doesn't exist in the graph");
+			};
+			auto const first = targets_.begin() + static_cast<std::ptrdiff_t>(offsets_[src_index]);
+			auto const last = targets_.begin() + static_cast<std::ptrdiff_t>(offsets_[src_index + 1]);
+			auto connections = std::vector<N>();
+			for (auto itor = first; itor != last; itor = std::upper_bound(itor, last, *itor)) {
+				connections.push_back(nodes_[*itor]);
+			};
+			return connections;
+		};
+
+		// Index access
+		// Nodes are numbered 0 to num_nodes() - 1 in sorted order; these let graph algorithms work
+		// on dense indices instead of values.
+		[[nodiscard]] auto num_nodes() const noexcept -> size_type {
+			return nodes_.size();
+		};
+
+		[[nodiscard]] auto num_edges() const noexcept -> size_type {
+			return targets_.size();
+		};
+
+		[[nodiscard]] auto node_index(N const& value) const -> std::optional<size_type> {
+			auto index = index_of(value);
+			return index == nodes_.size() ? std::nullopt : std::optional<size_type>(index);
+		};
+
+		[[nodiscard]] auto node(size_type index) const -> N const& {
+			return nodes_[index];
+		};
+
+		// Destination indices of the out-edges of index, sorted; out_weights(index) runs parallel
+		// to it, so the edges to each destination come lightest first.
+		[[nodiscard]] auto out_targets(size_type index) const -> std::span<size_type const> {
+			return targets_.subspan(offsets_[index], offsets_[index + 1] - offsets_[index]);
+		};
+
+		[[nodiscard]] auto out_weights(size_type index) const -> std::span<E const> {
+			return weights_.subspan(offsets_[index], offsets_[index + 1] - offsets_[index]);
+		};
+
+		// Source indices of the in-edges of index, sorted, with one entry per edge. The index of
+		// in-edges is built the first time any of them is asked for and is then shared by every
+		// copy of this snapshot; building it is thread-safe. An empty snapshot that was default
+		// constructed or moved from has no index, but no index is valid in it either.
+		[[nodiscard]] auto in_sources(size_type index) const -> std::span<size_type const> {
+			std::call_once(in_edges_->built, [this] { build_in_edges(); });
+			auto const& offsets = in_edges_->offsets;
+			auto const sources = std::span<size_type const>(in_edges_->sources);
+			return sources.subspan(offsets[index], offsets[index + 1] - offsets[index]);
+		};
+
+		// Iterator access
+		[[nodiscard]] auto begin() const -> iterator {
+			auto itor = iterator{this, 0, 0};
+			itor.skip_exhausted_sources();
+			return itor;
+		};
+
+		// O(1): parks on the last node directly, with no walk over the nodes without edges.
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator{this, nodes_.empty() ? 0 : nodes_.size() - 1, targets_.size()};
+		};
+
+		// Comparisons
+		[[nodiscard]] auto operator==(csr_graph const& other) const -> bool {
+			return std::ranges::equal(nodes_, other.nodes_)
+			       and std::ranges::equal(offsets_, other.offsets_)
+			       and std::ranges::equal(targets_, other.targets_)
+			       and std::ranges::equal(weights_, other.weights_);
+		};
+
+		// Binary format
+		// A header followed by the node, offset, target and weight arrays, each starting on a
+		// section_alignment boundary, in native byte order. Only available when N and E can be
+		// copied as raw bytes.
+		static constexpr auto binary_version = std::uint32_t{1};
+
+		auto write_binary(std::ostream& os) const -> std::ostream&
+		   requires std::is_trivially_copyable_v<N> and std::is_trivially_copyable_v<E>
+		{
+			auto const header = binary_header{.node_size = sizeof(N),
+			                                  .weight_size = sizeof(E),
+			                                  .num_nodes = nodes_.size(),
+			                                  .num_edges = targets_.size()};
+			auto const layout = binary_layout(header);
+			auto written = size_type{0};
+			auto write_section = [&](void const* data, size_type bytes, size_type position) {
+				static constexpr auto padding = std::array<char, section_alignment>{};
+				os.write(padding.data(), static_cast<std::streamsize>(position - written));
+				os.write(static_cast<char const*>(data), static_cast<std::streamsize>(bytes));
+				written = position + bytes;
+			};
+			write_section(&header, sizeof(header), 0);
+			write_section(nodes_.data(), nodes_.size_bytes(), layout[0]);
+			write_section(offsets_.data(), offsets_.size_bytes(), layout[1]);
+			write_section(targets_.data(), targets_.size_bytes(), layout[2]);
+			write_section(weights_.data(), weights_.size_bytes(), layout[3]);
+			return os;
+		};
+
+		// Maps a file written by write_binary and serves queries straight from the mapping, without
+		// copying or deserializing anything. The mapping lives as long as any copy of the result.
+		// The arrays are checked in one O(n + e) pass, so a corrupt file throws here rather than
+		// leading later queries out of bounds.
+		[[nodiscard]] static auto map_binary(std::filesystem::path const& path) -> csr_graph
+		   requires std::is_trivially_copyable_v<N> and std::is_trivially_copyable_v<E>
+		{
+			auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd == -1) {
+				throw std::runtime_error("Cannot call gdwg::csr_graph<N, E>::map_binary "
+				                         "if the file can't be opened");
+			};
+			struct stat status {};
+			auto const size = ::fstat(fd, &status) == 0 ? static_cast<size_type>(status.st_size) : 0;
+			auto* address = size < sizeof(binary_header)
+			                   ? MAP_FAILED
+			                   : ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			::close(fd);
+			if (address == MAP_FAILED) {
+				throw std::runtime_error("Cannot call gdwg::csr_graph<N, E>::map_binary "
+				                         "if the file isn't a binary csr_graph");
+			};
+
+			auto result = csr_graph();
+			result.storage_ = std::shared_ptr<void const>(address, [size](void const* p) {
+				::munmap(const_cast<void*>(p), size);
+			});
+			result.in_edges_ = std::make_shared<in_edge_index>();
+			auto const* bytes = static_cast<std::byte const*>(address);
+			auto header = binary_header{};
+			std::memcpy(&header, bytes, sizeof(header));
+			// The counts are bounded by the file size first so that the layout can't overflow.
+			if (not header.compatible() or header.num_nodes > size or header.num_edges > size
+			    or binary_layout(header)[4] > size)
+			{
+				throw std::runtime_error("Cannot call gdwg::csr_graph<N, E>::map_binary "
+				                         "if the file isn't a binary csr_graph");
+			};
+			auto const layout = binary_layout(header);
+			result.nodes_ = {reinterpret_cast<N const*>(bytes + layout[0]), header.num_nodes};
+			result.offsets_ = {reinterpret_cast<size_type const*>(bytes + layout[1]),
+			                   header.num_nodes + 1};
+			result.targets_ = {reinterpret_cast<size_type const*>(bytes + layout[2]),
+			                   header.num_edges};
+			result.weights_ = {reinterpret_cast<E const*>(bytes + layout[3]), header.num_edges};
+			if (not result.well_formed()) {
+				throw std::runtime_error("Cannot call gdwg::csr_graph<N, E>::map_binary "
+				                         "if the file isn't a binary csr_graph");
+			};
+			return result;
+		};
+
+	private:
+		// Owned storage for a snapshot built from a graph.
+		struct arrays {
+			std::vector<N> nodes;
+			std::vector<size_type> offsets;
+			std::vector<size_type> targets;
+			std::vector<E> weights;
+		};
+
+		static constexpr auto section_alignment = size_type{64};
+		static constexpr size_type empty_offsets[1] = {0};
+
+		struct binary_header {
+			std::array<char, 8> magic = {'G', 'D', 'W', 'G', 'C', 'S', 'R', '\0'};
+			std::uint32_t version = binary_version;
+			std::uint32_t byte_order = 0x01020304;
+			std::uint64_t node_size = 0;
+			std::uint64_t weight_size = 0;
+			std::uint64_t num_nodes = 0;
+			std::uint64_t num_edges = 0;
+
+			// Whether a file with this header was written by this csr_graph<N, E> on this platform.
+			[[nodiscard]] auto compatible() const -> bool {
+				auto const expected = binary_header{.node_size = sizeof(N), .weight_size = sizeof(E)};
+				return magic == expected.magic and version == expected.version
+				       and byte_order == expected.byte_order and node_size == expected.node_size
+				       and weight_size == expected.weight_size;
+			};
+		};
+		static_assert(sizeof(size_type) == sizeof(std::uint64_t));
+		static_assert(alignof(N) <= section_alignment and alignof(E) <= section_alignment);
+
+		// Start of the node, offset, target and weight sections, then the total file size.
+		static auto binary_layout(binary_header const& header) -> std::array<size_type, 5> {
+			auto const align = [](size_type position) {
+				return (position + section_alignment - 1) / section_alignment * section_alignment;
+			};
+			auto layout = std::array<size_type, 5>{};
+			layout[0] = align(sizeof(binary_header));
+			layout[1] = align(layout[0] + header.num_nodes * sizeof(N));
+			layout[2] = align(layout[1] + (header.num_nodes + 1) * sizeof(size_type));
+			layout[3] = align(layout[2] + header.num_edges * sizeof(size_type));
+			layout[4] = layout[3] + header.num_edges * sizeof(E);
+			return layout;
+		};
+
+		// Built on demand by in_sources, in CSR form like the out-edges. The block itself is
+		// allocated along with the storage, so that copies taken before the build share it too.
+		struct in_edge_index {
+			std::once_flag built;
+			std::vector<size_type> offsets;
+			std::vector<size_type> sources;
+		};
+
+		std::shared_ptr<void const> storage_;
+		std::shared_ptr<in_edge_index> in_edges_;
+		std::span<N const> nodes_;
+		std::span<size_type const> offsets_ = empty_offsets;
+		std::span<size_type const> targets_;
+		std::span<E const> weights_;
+
+		auto swap_contents(csr_graph& other) noexcept -> void {
+			std::swap(storage_, other.storage_);
+			std::swap(in_edges_, other.in_edges_);
+			std::swap(nodes_, other.nodes_);
+			std::swap(offsets_, other.offsets_);
+			std::swap(targets_, other.targets_);
+			std::swap(weights_, other.weights_);
+		};
+
+		auto build_in_edges() const -> void {
+			auto& offsets = in_edges_->offsets;
+			offsets.assign(nodes_.size() + 1, 0);
+			for (auto const to : targets_) {
+				++offsets[to + 1];
+			};
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+			auto& sources = in_edges_->sources;
+			sources.resize(targets_.size());
+			auto next = std::vector<size_type>(offsets.begin(), offsets.end() - 1);
+			for (auto from = size_type{0}; from < nodes_.size(); ++from) {
+				for (auto i = offsets_[from]; i < offsets_[from + 1]; ++i) {
+					sources[next[targets_[i]]++] = from;
+				};
+			};
+		};
+
+		// Whether the arrays describe a snapshot: nodes strictly sorted, offsets running from 0 up
+		// to the number of edges without decreasing, and every target a node index.
+		auto well_formed() const -> bool {
+			auto const out_of_order = [](auto const& lhs, auto const& rhs) { return not(lhs < rhs); };
+			return std::adjacent_find(nodes_.begin(), nodes_.end(), out_of_order) == nodes_.end()
+			       and offsets_.front() == 0 and offsets_.back() == targets_.size()
+			       and std::is_sorted(offsets_.begin(), offsets_.end())
+			       and std::all_of(targets_.begin(), targets_.end(), [this](size_type to) {
+				          return to < nodes_.size();
+			          });
+		};
+
+		// The node owning the edge at pos; past the last edge, the last node (as iterators park).
+		auto source_of(size_type pos) const -> size_type {
+			if (nodes_.empty()) {
+				return 0;
+			};
+			auto const ends = offsets_.subspan(1);
+			auto const owner = std::upper_bound(ends.begin(), ends.end(), pos) - ends.begin();
+			return std::min(static_cast<size_type>(owner), nodes_.size() - 1);
+		};
+
+		// Position of value in nodes_, or nodes_.size() if it is not a node.
+		auto index_of(N const& value) const -> size_type {
+			auto itor = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			if (itor == nodes_.end() or value < *itor) {
+				return nodes_.size();
+			};
+			return static_cast<size_type>(itor - nodes_.begin());
+		};
+
+		// Range of targets_ holding the edges from src_index to dest_index.
+		auto targets_of(size_type src_index, size_type dest_index) const {
+			auto const first = targets_.begin() + static_cast<std::ptrdiff_t>(offsets_[src_index]);
+			auto const last = targets_.begin() + static_cast<std::ptrdiff_t>(offsets_[src_index + 1]);
+			return std::equal_range(first, last, dest_index);
+		};
+	};
+
+	template<typename N, typename E, typename Alloc, typename Index>
+	csr_graph(graph<N, E, Alloc, Index> const&) -> csr_graph<N, E>;
+} // namespace gdwg
+#endif // GDWG_CSR_GRAPH_HPP
@@ -1,18 +1,89 @@
 #ifndef GDWG_GRAPH_HPP
 #define GDWG_GRAPH_HPP
 
+#include <gdwg/node_table.hpp>
+
 #include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <memory_resource>
+#include <optional>
+#include <ranges>
 #include <set>
-#include <sstream>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 // This will not compile straight away
 namespace gdwg {
 	template<typename N, typename E>
+	class csr_graph;
+
+	// Node lookup policies for graph. With ordered_index nodes are found by searching the sorted
+	// node set, in O(log n) comparisons. hashed_index also keeps a flat hash table from value to
+	// node, so lookups by value take O(1) hashes and (usually) one comparison, at the cost of the
+	// table's memory and of hashing on insert and erase; N must then be hashable with std::hash.
+	// Either way the nodes stay sorted, so nodes(), iteration and operator<< keep their order.
+	struct ordered_index {};
+	struct hashed_index {};
+
+	namespace detail {
+		// Types that graph<N, E> compares with N directly when looking a node up, such as
+		// std::string_view or a string literal for N = std::string. Arithmetic types are left out so
+		// that, say, 1.5 still converts to the int node 1 rather than matching none.
+		template<typename K, typename N>
+		concept lookup_key = std::same_as<K, N>
+		                     or (not std::is_arithmetic_v<K>
+		                         and requires(K const& key, N const& value) {
+			                         { key < value } -> std::convertible_to<bool>;
+			                         { value < key } -> std::convertible_to<bool>;
+			                         { value == key } -> std::convertible_to<bool>;
+		                         });
+
+		// Types a node can be looked up by: lookup keys, and types that convert to N, which are
+		// converted first.
+		template<typename K, typename N>
+		concept node_key = lookup_key<K, N> or std::convertible_to<K const&, N>;
+
+		template<typename T>
+		concept hashable = requires(T const& value) {
+			{ std::hash<T>{}(value) } -> std::convertible_to<std::size_t>;
+		};
+
+		// The splitmix64 finalizer. Spreads weak hashes, such as the identity std::hash<int>, so
+		// that sums of them don't collide for nearby values.
+		constexpr auto mix_hash(std::uint64_t x) -> std::uint64_t {
+			x = (x ^ (x >> 30U)) * 0xbf58476d1ce4e5b9U;
+			x = (x ^ (x >> 27U)) * 0x94d049bb133111ebU;
+			return x ^ (x >> 31U);
+		};
+	} // namespace detail
+
+	// Alloc is rebound for every internal allocation; with a scoped or polymorphic allocator it is
+	// also passed on to node values and weights via uses-allocator construction.
+	//
+	// Members that look nodes up by value take any detail::node_key of N. Keys that compare with N,
+	// like std::string_view or a string literal for N = std::string, are compared with the nodes
+	// as they are, so lookups neither build an N nor allocate; other keys are converted to N.
+	//
+	// When N and E are hashable, the graph keeps a hash of its contents: the sum of a hash of every
+	// node and every edge, so it does not depend on insertion order. Every insertion and erasure
+	// adjusts it in O(1). operator== rejects graphs whose hashes differ without visiting them,
+	// and std::hash<graph> returns the hash.
+	template<typename N,
+	         typename E,
+	         typename Alloc = std::allocator<std::byte>,
+	         typename Index = ordered_index>
 	class graph {
 	public:
+		using allocator_type = Alloc;
+
 		struct value_type {
 			N from;
 			N to;
@@ -24,136 +95,384 @@ namespace gdwg {
 			~value_type() = default;
 		};
 
+		// What iterators yield: an edge's endpoints and weight, referring into the graph rather
+		// than copied out of it. Structured bindings name the referred-to values; converting to
+		// value_type copies them.
+		struct reference {
+			N const& from;
+			N const& to;
+			E const& weight;
+
+			operator value_type() const {
+				return value_type{from, to, weight};
+			};
+		};
+
 	private:
-		struct edge {
-			N* src;
-			N* dest;
-			std::unique_ptr<E> weight;
+		using alloc_traits = std::allocator_traits<Alloc>;
 
-			auto operator==(edge const& other) const -> bool {
-				return std::tie(*src, *dest, *weight) == std::tie(*other.src, *other.dest, *other.weight);
+		template<typename T>
+		using rebind_alloc = typename alloc_traits::template rebind_alloc<T>;
+
+		// Node values and edge weights live inline in the std::set elements. A set never relocates
+		// its elements (not on insert, erase of others, extract/reinsert or container move), so
+		// edges can keep raw pointers to their endpoint nodes without a separate heap allocation.
+		struct node;
+		struct edge;
+
+		// Prefix keys for range queries: edges_ is grouped by source, then by destination
+		struct src_key {
+			node const* src;
+		};
+
+		struct src_dest_key {
+			node const* src;
+			node const* dest;
+		};
+
+		// Full keys that refer to their parts instead of copying them: one by endpoint nodes, and one
+		// by endpoint values, which may be any lookup keys.
+		struct src_dest_weight_key {
+			node const* src;
+			node const* dest;
+			E const& weight;
+		};
+
+		template<typename Src, typename Dest>
+		struct value_key {
+			Src const& from;
+			Dest const& to;
+			E const& weight;
+		};
+
+		// Node values are unique, so two endpoints are equal exactly when they are the same node: the
+		// comparisons between edges and node keys only compare values for different nodes.
+		struct edge_cmp {
+			using is_transparent = std::true_type;
+			auto operator()(edge const& lhs, edge const& rhs) const -> bool {
+				if (lhs.src != rhs.src) {
+					return lhs.src->value < rhs.src->value;
+				};
+				if (lhs.dest != rhs.dest) {
+					return lhs.dest->value < rhs.dest->value;
+				};
+				return lhs.weight < rhs.weight;
 			};
 
-			// Constructor
-			edge(N* src, N* dest, E const& weight)
+			auto operator()(value_type const& lhs, edge const& rhs) const -> bool {
+				return std::tie(lhs.from, lhs.to, lhs.weight)
+				       < std::tie(rhs.src->value, rhs.dest->value, rhs.weight);
+			};
+
+			auto operator()(edge const& lhs, value_type const& rhs) const -> bool {
+				return std::tie(lhs.src->value, lhs.dest->value, lhs.weight)
+				       < std::tie(rhs.from, rhs.to, rhs.weight);
+			};
+
+			auto operator()(src_dest_weight_key const& lhs, edge const& rhs) const -> bool {
+				if (lhs.src != rhs.src) {
+					return lhs.src->value < rhs.src->value;
+				};
+				if (lhs.dest != rhs.dest) {
+					return lhs.dest->value < rhs.dest->value;
+				};
+				return lhs.weight < rhs.weight;
+			};
+
+			auto operator()(edge const& lhs, src_dest_weight_key const& rhs) const -> bool {
+				if (lhs.src != rhs.src) {
+					return lhs.src->value < rhs.src->value;
+				};
+				if (lhs.dest != rhs.dest) {
+					return lhs.dest->value < rhs.dest->value;
+				};
+				return lhs.weight < rhs.weight;
+			};
+
+			template<typename Src, typename Dest>
+			auto operator()(value_key<Src, Dest> const& lhs, edge const& rhs) const -> bool {
+				return std::tie(lhs.from, lhs.to, lhs.weight)
+				       < std::tie(rhs.src->value, rhs.dest->value, rhs.weight);
+			};
+
+			template<typename Src, typename Dest>
+			auto operator()(edge const& lhs, value_key<Src, Dest> const& rhs) const -> bool {
+				return std::tie(lhs.src->value, lhs.dest->value, lhs.weight)
+				       < std::tie(rhs.from, rhs.to, rhs.weight);
+			};
+
+			auto operator()(src_key const& lhs, edge const& rhs) const -> bool {
+				return less(lhs.src, rhs.src);
+			};
+
+			auto operator()(edge const& lhs, src_key const& rhs) const -> bool {
+				return less(lhs.src, rhs.src);
+			};
+
+			auto operator()(src_dest_key const& lhs, edge const& rhs) const -> bool {
+				return lhs.src != rhs.src ? lhs.src->value < rhs.src->value : less(lhs.dest, rhs.dest);
+			};
+
+			auto operator()(edge const& lhs, src_dest_key const& rhs) const -> bool {
+				return lhs.src != rhs.src ? lhs.src->value < rhs.src->value : less(lhs.dest, rhs.dest);
+			};
+
+			static auto less(node const* lhs, node const* rhs) -> bool {
+				return lhs != rhs and lhs->value < rhs->value;
+			};
+		};
+
+		struct edge {
+			node const* src;
+			node const* dest;
+			E weight;
+
+			// Links in the intrusive list of edges incoming to `dest`
+			mutable edge const* prev_in = nullptr;
+			mutable edge const* next_in = nullptr;
+			// Links in the list of edges outgoing from `src`, which follows the order of edges_
+			mutable edge const* prev_out = nullptr;
+			mutable edge const* next_out = nullptr;
+			// Where this edge sits in the edge set, so it can be erased without a search
+			mutable typename std::set<edge, edge_cmp, rebind_alloc<edge>>::const_iterator self = {};
+
+			// Constructors
+			using allocator_type = Alloc;
+
+			edge(node const* src, node const* dest, E const& weight)
 			: src{src}
 			, dest{dest}
-			, weight{std::make_unique<E>(weight)} {};
+			, weight{weight} {};
+
+			edge(std::allocator_arg_t,
+			     Alloc const& alloc,
+			     node const* from,
+			     node const* to,
+			     E const& w)
+			: src{from}
+			, dest{to}
+			, weight{std::make_obj_using_allocator<E>(alloc, w)} {};
 
 			// Rule of 5
-			edge(edge const&& orig) noexcept = default;
+			edge(edge&& orig) noexcept = default;
 			auto operator=(edge&& orig) noexcept -> edge& = default;
 			edge(edge const& orig) = delete;
 			auto operator=(edge const& orig) -> edge& = delete;
 			~edge() = default;
 		};
 
-		struct edge_cmp {
+		struct node_cmp {
 			using is_transparent = std::true_type;
-			auto operator()(edge const& lhs, edge const& rhs) const -> bool {
-				return std::tie(*lhs.src, *lhs.dest, *lhs.weight)
-				       < std::tie(*rhs.src, *rhs.dest, *rhs.weight);
+			auto operator()(node const& lhs, node const& rhs) const -> bool {
+				return lhs.value < rhs.value;
 			};
 
-			auto operator()(value_type const& lhs, edge const& rhs) const -> bool {
-				return std::tie(lhs.from, lhs.to, lhs.weight)
-				       < std::tie(*rhs.src, *rhs.dest, *rhs.weight);
+			template<typename K>
+			auto operator()(node const& lhs, K const& rhs) const -> bool {
+				return lhs.value < rhs;
 			};
 
-			auto operator()(edge const& lhs, value_type const& rhs) const -> bool {
-				return std::tie(*lhs.src, *lhs.dest, *lhs.weight)
-				       < std::tie(rhs.from, rhs.to, rhs.weight);
+			template<typename K>
+			auto operator()(K const& lhs, node const& rhs) const -> bool {
+				return lhs < rhs.value;
 			};
 		};
 
 		struct node {
-			std::unique_ptr<N> value;
+			N value;
 
-			auto operator==(node const& other) const -> bool {
-				return *value == *other.value;
-			};
+			// Where this node sits in the node set, so it can be erased without a search
+			mutable typename std::set<node, node_cmp, rebind_alloc<node>>::const_iterator self = {};
+
+			// Head of the intrusive list of edges whose dest is this node
+			mutable edge const* in_head = nullptr;
+			// First of the edges whose src is this node, so they can be walked without a search
+			mutable edge const* out_head = nullptr;
+			// Length of the out-list, so edges can be apportioned by source without walking them
+			mutable std::size_t out_degree = 0;
+			// This node's share of the graph's content hash, which its edges' shares build on
+			std::size_t hash = hash_node(value);
+
+			// Constructors
+			using allocator_type = Alloc;
 
-			// Constructor
 			explicit node(N const& value)
-			: value{std::make_unique<N>(value)} {};
+			: value{value} {};
+
+			node(std::allocator_arg_t, Alloc const& alloc, N const& v)
+			: value{std::make_obj_using_allocator<N>(alloc, v)} {};
 
 			// Rule of 5
-			node(node const&& orig) noexcept = default;
+			node(node&& orig) noexcept = default;
 			auto operator=(node&& orig) noexcept -> node& = default;
 			node(node const& orig) = delete;
 			auto operator=(node const& orig) -> node& = delete;
 			~node() = default;
 		};
 
-		struct node_cmp {
-			using is_transparent = std::true_type;
-			auto operator()(node const& lhs, node const& rhs) const -> bool {
-				return *lhs.value < *rhs.value;
+		using node_set = std::set<node, node_cmp, rebind_alloc<node>>;
+		using edge_set = std::set<edge, edge_cmp, rebind_alloc<edge>>;
+		using node_itor = typename node_set::const_iterator;
+		using edge_itor = typename edge_set::const_iterator;
+
+		// Follows a source's out-list; the default-constructed iterator is past its last edge.
+		class out_edge_iterator {
+		public:
+			using value_type = edge;
+			using difference_type = std::ptrdiff_t;
+
+			out_edge_iterator() = default;
+
+			explicit out_edge_iterator(edge const* e)
+			: e_{e} {};
+
+			auto operator*() const -> edge const& {
+				return *e_;
 			};
 
-			auto operator()(node const& lhs, N const& rhs) const -> bool {
-				return *lhs.value < rhs;
+			auto operator++() -> out_edge_iterator& {
+				e_ = e_->next_out;
+				return *this;
 			};
 
-			auto operator()(N const& lhs, node const& rhs) const -> bool {
-				return lhs < *rhs.value;
+			auto operator++(int) -> out_edge_iterator {
+				auto tmp = *this;
+				++(*this);
+				return tmp;
 			};
+
+			auto operator==(out_edge_iterator const& other) const -> bool = default;
+
+		private:
+			edge const* e_ = nullptr;
 		};
 
-		std::set<node, node_cmp> nodes_;
-		std::set<edge, edge_cmp> edges_;
+		static_assert(std::is_same_v<Index, ordered_index> or std::is_same_v<Index, hashed_index>,
+		              "gdwg::graph's Index must be gdwg::ordered_index or gdwg::hashed_index");
+		static constexpr auto hashed = std::is_same_v<Index, hashed_index>;
+		using node_table = detail::node_table<N, node_itor, rebind_alloc<node_itor>>;
+		using node_index = std::conditional_t<hashed, node_table, Index>;
+
+		static constexpr auto content_hashed = detail::hashable<N> and detail::hashable<E>;
+
+		node_set nodes_;
+		edge_set edges_;
+		[[no_unique_address]] node_index index_;
+		// Sum of the hashes of the nodes and edges, wrapping; zero unless content_hashed
+		std::size_t hash_ = 0;
+
+		friend class csr_graph<N, E>;
+		friend struct std::hash<graph>;
 
 	public:
 		// Constructors
-		graph() = default;
+		graph()
+		: graph(Alloc()){};
 
-		graph(std::initializer_list<N> il)
-		: graph(il.begin(), il.end()){};
+		explicit graph(Alloc const& alloc)
+		: nodes_(rebind_alloc<node>(alloc))
+		, edges_(rebind_alloc<edge>(alloc))
+		, index_{make_index(alloc)} {};
 
+		graph(std::initializer_list<N> il, Alloc const& alloc = Alloc())
+		: graph(il.begin(), il.end(), alloc){};
+
+		// Sorted input is placed with end hints, so it loads in linear time.
 		template<typename InputIt>
-		graph(InputIt first, InputIt last) {
-			std::for_each(first, last, [&](N const& n) { insert_node(n); });
+		graph(InputIt first, InputIt last, Alloc const& alloc = Alloc())
+		: graph(alloc) {
+			std::for_each(first, last, [&](N const& n) { emplace_node_hint(nodes_.end(), n); });
+		};
+
+		// Bulk load from a range of N and a range of value_type (see insert_edges).
+		template<typename NodeIt, typename EdgeIt>
+		graph(NodeIt first_node,
+		      NodeIt last_node,
+		      EdgeIt first_edge,
+		      EdgeIt last_edge,
+		      Alloc const& alloc = Alloc())
+		: graph(first_node, last_node, alloc) {
+			insert_edges(first_edge, last_edge);
 		};
 
 		// Move constructor
-		graph(graph&& orig) noexcept = default;
+		graph(graph&& orig) noexcept
+		: nodes_(std::move(orig.nodes_))
+		, edges_(std::move(orig.edges_))
+		, index_(std::move(orig.index_))
+		, hash_{std::exchange(orig.hash_, 0)} {};
+
+		graph(graph&& orig, Alloc const& alloc)
+		: graph(alloc) {
+			if (get_allocator() == orig.get_allocator()) {
+				swap_contents(orig);
+			}
+			else {
+				clone_from(orig);
+				orig.clear();
+			};
+		};
 
 		// Move	assignment
-		auto operator=(graph&& orig) noexcept -> graph& = default;
+		auto operator=(graph&& orig) noexcept(alloc_traits::propagate_on_container_move_assignment::value
+		                                      or alloc_traits::is_always_equal::value) -> graph& {
+			if (this == &orig) {
+				return *this;
+			};
+			clear();
+			// Either the set nodes are handed over as they are, so edges keep pointing at valid nodes,
+			// or the elements are copied into memory from this graph's allocator.
+			if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+				nodes_ = std::move(orig.nodes_);
+				edges_ = std::move(orig.edges_);
+				index_ = std::move(orig.index_);
+				hash_ = orig.hash_;
+			}
+			else if (get_allocator() == orig.get_allocator()) {
+				swap_contents(orig);
+			}
+			else {
+				clone_from(orig);
+			};
+			orig.clear();
+			return *this;
+		};
 
 		// Copy constructor
-		graph(graph const& orig) {
-			std::for_each(orig.nodes_.begin(), orig.nodes_.end(), [&](node const& n) {
-				insert_node(*n.value);
-			});
-			std::for_each(orig.edges_.begin(), orig.edges_.end(), [&](edge const& e) {
-				insert_edge(*e.src, *e.dest, *e.weight);
-			});
+		graph(graph const& orig)
+		: graph(orig, alloc_traits::select_on_container_copy_construction(orig.get_allocator())){};
+
+		graph(graph const& orig, Alloc const& alloc)
+		: graph(alloc) {
+			clone_from(orig);
 		};
 
 		// Copy assignment
 		auto operator=(graph const& orig) -> graph& {
 			if (this != &orig) {
-				edges_.clear();
-				nodes_.clear();
-				std::for_each(orig.nodes_.begin(), orig.nodes_.end(), [&](node const& n) {
-					insert_node(*n.value);
-				});
-				std::for_each(orig.edges_.begin(), orig.edges_.end(), [&](edge const& e) {
-					insert_edge(*e.src, *e.dest, *e.weight);
-				});
+				if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+					if (get_allocator() != orig.get_allocator()) {
+						return *this = graph(orig, orig.get_allocator());
+					};
+				};
+				clear();
+				clone_from(orig);
 			};
 			return *this;
 		};
 
+		[[nodiscard]] auto get_allocator() const noexcept -> allocator_type {
+			return allocator_type(nodes_.get_allocator());
+		};
+
 		// Destructor
 		~graph() = default;
 
 		// Iterator
 		class iterator {
 		public:
-			using value_type = graph<N, E>::value_type;
-			using reference = value_type;
+			using value_type = graph::value_type;
+			using reference = graph::reference;
 			using pointer = void;
 			using difference_type = std::ptrdiff_t;
 			using iterator_category = std::bidirectional_iterator_tag;
@@ -162,8 +481,8 @@ namespace gdwg {
 			iterator() = default;
 
 			// Iterator source
-			auto operator*() -> reference {
-				return value_type{*(itor_->src), *(itor_->dest), *(itor_->weight)};
+			auto operator*() const -> reference {
+				return reference{itor_->src->value, itor_->dest->value, itor_->weight};
 			};
 
 			// Iterator traversal
@@ -195,32 +514,134 @@ namespace gdwg {
 			};
 
 		private:
-			using edge_itor = typename std::set<edge, edge_cmp>::iterator;
 			edge_itor itor_;
 
 			explicit iterator(edge_itor itor)
 			: itor_{itor} {};
 
-			friend class graph<N, E>;
+			friend class graph;
+		};
+
+		// Handle to a node, for calls that would otherwise look the node up by value each time (see
+		// the _by_id members). Like an iterator it stays valid until its node is erased, replaced or
+		// merged away, or the graph is cleared or assigned to; using it after that is undefined.
+		class node_id {
+		public:
+			node_id() = default;
+
+			auto operator==(node_id const& other) const -> bool = default;
+
+		private:
+			node const* node_ = nullptr;
+
+			explicit node_id(node const* n)
+			: node_{n} {};
+
+			friend class graph;
 		};
 
 		// Modifiers
 		auto insert_node(N const& value) -> bool {
-			return nodes_.emplace(value).second;
+			return emplace_node(value).second;
+		};
+
+		// Like insert_node, but also returns the id of the node holding value, new or not.
+		auto emplace_node(N const& value) -> std::pair<node_id, bool> {
+			if constexpr (hashed) {
+				auto itor = find_node_itor(value);
+				if (itor != nodes_.end()) {
+					return {node_id{&*itor}, false};
+				};
+				index_.reserve_one();
+				itor = nodes_.emplace(value).first;
+				itor->self = itor;
+				index_.insert(itor);
+				hash_ += itor->hash;
+				return {node_id{&*itor}, true};
+			}
+			else {
+				auto [itor, inserted] = nodes_.emplace(value);
+				if (inserted) {
+					itor->self = itor;
+					hash_ += itor->hash;
+				};
+				return {node_id{&*itor}, inserted};
+			};
 		};
 
-		auto insert_edge(N const& src, N const& dest, E const& weight) -> bool {
-			auto src_itor = nodes_.find(src);
-			auto dest_itor = nodes_.find(dest);
+		template<typename Src = N, typename Dest = N>
+			requires detail::node_key<Src, N> and detail::node_key<Dest, N>
+		auto insert_edge(Src const& src, Dest const& dest, E const& weight) -> bool {
+			auto src_itor = find_node_itor(src);
+			auto dest_itor = find_node_itor(dest);
 			if (not(src_itor != nodes_.end() and dest_itor != nodes_.end())) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edge "
 				                         "when either src or dst node does not exist");
 			};
-			return edges_.emplace(src_itor->value.get(), dest_itor->value.get(), weight).second;
+			return insert_edge_by_id(node_id{&*src_itor}, node_id{&*dest_itor}, weight);
 		};
 
-		auto replace_node(N const& old_data, N const& new_data) -> bool {
-			auto old_itor = nodes_.find(old_data);
+		auto insert_edge_by_id(node_id src, node_id dest, E const& weight) -> bool {
+			auto [itor, inserted] = edges_.emplace(src.node_, dest.node_, weight);
+			if (inserted) {
+				link(itor);
+			};
+			return inserted;
+		};
+
+		// Inserts every edge of a range of value_type or reference (such as another graph's) and
+		// returns how many were new. Each edge of input sorted by (from, to, weight) is placed in
+		// amortised O(1) with a hint just after the previous one, and while sources arrive in
+		// order they are found by moving a cursor forward over the nodes, O(n) over the whole load.
+		// A destination equal or adjacent to the previous edge's is found in O(1); any other is
+		// looked up, in O(1) expected with hashed_index, so sorted input loads in O(n + e) with
+		// hashed_index. With ordered_index each destination jump costs O(log n): destinations
+		// restart under every source, so no single cursor can follow them.
+		//
+		// Sortedness is checked as the edges arrive rather than promised by the caller, at one
+		// comparison per edge, so unsorted or duplicated input is still loaded correctly, at the
+		// cost of repeated insert_edge.
+		template<typename InputIt>
+		auto insert_edges(InputIt first, InputIt last) -> std::size_t {
+			auto inserted = std::size_t{0};
+			auto hint = edges_.end();
+			auto src_itor = nodes_.begin();
+			auto dest_itor = nodes_.end();
+			auto sources_in_order = true;
+			std::for_each(first, last, [&](auto const& e) {
+				sources_in_order = sources_in_order and src_itor != nodes_.end()
+				                   and not(e.from < src_itor->value);
+				if (sources_in_order) {
+					while (src_itor != nodes_.end() and src_itor->value < e.from) {
+						++src_itor;
+					};
+					if (src_itor != nodes_.end() and e.from < src_itor->value) {
+						src_itor = nodes_.end();
+					};
+				}
+				else {
+					src_itor = find_node_near(src_itor, e.from);
+				};
+				dest_itor = find_node_near(dest_itor, e.to);
+				if (src_itor == nodes_.end() or dest_itor == nodes_.end()) {
+					throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edges "
+					                         "when either src or dst node does not exist");
+				};
+				auto const size = edges_.size();
+				hint = edges_.emplace_hint(hint, &*src_itor, &*dest_itor, e.weight);
+				if (edges_.size() != size) {
+					link(hint);
+					++inserted;
+				};
+				++hint;
+			});
+			return inserted;
+		};
+
+		template<typename K = N>
+			requires detail::node_key<K, N>
+		auto replace_node(K const& old_data, N const& new_data) -> bool {
+			auto old_itor = find_node_itor(old_data);
 			if (old_itor == nodes_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::replace_node "
 				                         "on a node that doesn't exist");
@@ -228,26 +649,17 @@ namespace gdwg {
 			if (is_node(new_data)) {
 				return false;
 			};
-			nodes_.emplace(new_data);
-			auto old_edges = std::vector<value_type>{};
-			std::for_each(edges_.begin(), edges_.end(), [&](edge const& e) {
-				if (e.src == old_itor->value.get() || e.dest == old_itor->value.get()) {
-					old_edges.push_back(value_type{*e.src, *e.dest, *e.weight});
-				};
-			});
-			std::for_each(old_edges.begin(), old_edges.end(), [&](value_type const& e) {
-				auto const& new_src = e.from == old_data ? new_data : e.from;
-				auto const& new_dest = e.to == old_data ? new_data : e.to;
-				insert_edge(new_src, new_dest, e.weight);
-				erase_edge(e.from, e.to, e.weight);
-			});
-			nodes_.erase(old_itor);
+			auto new_itor = emplace_node_hint(nodes_.end(), new_data);
+			retarget_edges(*old_itor, *new_itor);
+			erase_node_entry(old_itor);
 			return true;
 		};
 
-		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
-			auto old_itor = nodes_.find(old_data);
-			auto new_itor = nodes_.find(new_data);
+		template<typename Old = N, typename New = N>
+			requires detail::node_key<Old, N> and detail::node_key<New, N>
+		auto merge_replace_node(Old const& old_data, New const& new_data) -> void {
+			auto old_itor = find_node_itor(old_data);
+			auto new_itor = find_node_itor(new_data);
 			if (old_itor == nodes_.end() || new_itor == nodes_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_node "
 				                         "on old or new data if they don't exist in the graph");
@@ -255,134 +667,251 @@ namespace gdwg {
 			if (old_itor == new_itor) {
 				return;
 			};
-			auto edges = std::vector<value_type>{};
-			std::for_each(edges_.begin(), edges_.end(), [&](edge const& e) {
-				if (e.src == old_itor->value.get() || e.dest == old_itor->value.get()) {
-					edges.push_back(value_type{*e.src, *e.dest, *e.weight});
-				};
-			});
-			std::for_each(edges.begin(), edges.end(), [&](value_type const& e) {
-				auto const& new_src = e.from == old_data ? new_data : e.from;
-				auto const& new_dest = e.to == old_data ? new_data : e.to;
-				if (edges_.find(value_type{new_src, new_dest, e.weight}) == edges_.end()) {
-					insert_edge(new_src, new_dest, e.weight);
-				};
-				erase_edge(e.from, e.to, e.weight);
-			});
-			nodes_.erase(old_itor);
+			retarget_edges(*old_itor, *new_itor);
+			erase_node_entry(old_itor);
 		};
 
-		auto erase_node(N const& value) -> bool {
-			auto itor = nodes_.find(value);
+		template<typename K = N>
+			requires detail::node_key<K, N>
+		auto erase_node(K const& value) -> bool {
+			auto itor = find_node_itor(value);
 			if (itor == nodes_.end()) {
 				return false;
 			};
-			auto edges = std::vector<value_type>{};
-			std::for_each(edges_.begin(), edges_.end(), [&](edge const& e) {
-				if (e.src == itor->value.get() || e.dest == itor->value.get()) {
-					edges.push_back(value_type{*e.src, *e.dest, *e.weight});
-				};
-			});
-			std::for_each(edges.begin(), edges.end(), [&](value_type const& e) {
-				erase_edge(e.from, e.to, e.weight);
-			});
-			nodes_.erase(itor);
+			erase_node_itor(itor);
 			return true;
 		};
 
-		auto erase_edge(N const& src, N const& dest, E const& weight) -> bool {
-			auto src_itor = nodes_.find(src);
-			auto dest_itor = nodes_.find(dest);
+		auto erase_node_by_id(node_id id) -> void {
+			erase_node_itor(id.node_->self);
+		};
+
+		template<typename Src = N, typename Dest = N>
+			requires detail::node_key<Src, N> and detail::node_key<Dest, N>
+		auto erase_edge(Src const& src, Dest const& dest, E const& weight) -> bool {
+			auto src_itor = find_node_itor(src);
+			auto dest_itor = find_node_itor(dest);
 			if (src_itor == nodes_.end() or dest_itor == nodes_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edge "
 				                         "on src or dst if they don't exist in the graph");
 			};
-			auto edge_itor = edges_.find(value_type(src, dest, weight));
-			if (edge_itor == edges_.end()) {
+			auto itor = edges_.find(src_dest_weight_key{&*src_itor, &*dest_itor, weight});
+			if (itor == edges_.end()) {
 				return false;
 			};
-			edges_.erase(edge_itor);
+			erase_edge_itor(itor);
 			return true;
 		};
 
 		auto erase_edge(iterator i) -> iterator {
-			return iterator{edges_.erase(i.itor_)};
+			return iterator{erase_edge_itor(i.itor_)};
 		};
 		auto erase_edge(iterator i, iterator s) -> iterator {
-			return iterator{edges_.erase(i.itor_, s.itor_)};
+			auto itor = i.itor_;
+			while (itor != s.itor_) {
+				itor = erase_edge_itor(itor);
+			};
+			return iterator{itor};
+		};
+
+		// Erases every edge of a range of value_type that is in the graph and returns how many were
+		// erased. The requests are sorted, so each source is looked up once, and each destination
+		// once per source; matches are then found in a single pass over edges_ in the same order,
+		// which only searches when it moves on to a new (src, dst) pair. Nothing is copied out of
+		// the requests. If any endpoint does not exist this throws before erasing anything.
+		template<typename InputIt>
+		auto erase_edges(InputIt first, InputIt last) -> std::size_t {
+			// Only lvalues of value_type itself can be pointed at; anything that merely converts to
+			// value_type would bind the lambda's parameter to a temporary.
+			if constexpr (std::forward_iterator<InputIt>
+			              and std::is_lvalue_reference_v<std::iter_reference_t<InputIt>>
+			              and std::same_as<std::remove_cvref_t<std::iter_reference_t<InputIt>>,
+			                               value_type>)
+			{
+				auto requests = std::vector<edge_request, rebind_alloc<edge_request>>(get_allocator());
+				std::for_each(first, last, [&requests](value_type const& e) {
+					requests.push_back(edge_request{&e, nullptr, nullptr});
+				});
+				return erase_edge_requests(requests);
+			}
+			else {
+				// The iterators yield temporaries, other types, or references into a graph (maybe
+				// this one) that erasing could invalidate, so work from copies of the values.
+				auto const values =
+				   std::vector<value_type, rebind_alloc<value_type>>(first, last, get_allocator());
+				return erase_edges(values.begin(), values.end());
+			};
 		};
 
 		auto clear() noexcept -> void {
-			nodes_.clear();
 			edges_.clear();
+			nodes_.clear();
+			if constexpr (hashed) {
+				index_.clear();
+			};
+			hash_ = 0;
 		};
 
 		// Accessors
-		[[nodiscard]] auto is_node(N const& value) const -> bool {
-			return nodes_.find(value) != nodes_.end();
+		template<typename K = N>
+			requires detail::node_key<K, N>
+		[[nodiscard]] auto is_node(K const& value) const -> bool {
+			return find_node_itor(value) != nodes_.end();
 		};
 
 		[[nodiscard]] auto empty() const noexcept -> bool {
 			return nodes_.empty();
 		};
 
-		[[nodiscard]] auto is_connected(N const& src, N const& dest) const -> bool {
-			auto src_itor = nodes_.find(src);
-			auto dest_itor = nodes_.find(dest);
+		[[nodiscard]] auto num_nodes() const noexcept -> std::size_t {
+			return nodes_.size();
+		};
+
+		[[nodiscard]] auto num_edges() const noexcept -> std::size_t {
+			return edges_.size();
+		};
+
+		template<typename Src = N, typename Dest = N>
+			requires detail::node_key<Src, N> and detail::node_key<Dest, N>
+		[[nodiscard]] auto is_connected(Src const& src, Dest const& dest) const -> bool {
+			auto src_itor = find_node_itor(src);
+			auto dest_itor = find_node_itor(dest);
 			if (src_itor == nodes_.end() or dest_itor == nodes_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::is_connected "
 				                         "if src or dst node don't exist in the graph");
 			};
-			return std::find_if(edges_.begin(),
-			                    edges_.end(),
-			                    [&src_itor, &dest_itor](auto const& e) {
-				                    return e.src == src_itor->value.get()
-				                           and e.dest == dest_itor->value.get();
-			                    })
-			       != edges_.end();
+			return edges_.contains(src_dest_key{&*src_itor, &*dest_itor});
 		};
 
 		[[nodiscard]] auto nodes() const -> std::vector<N> {
 			auto nodes = std::vector<N>();
 			std::transform(nodes_.begin(), nodes_.end(), std::back_inserter(nodes), [](auto const& n) {
-				return *n.value;
+				return n.value;
 			});
 			return nodes;
 		};
 
-		[[nodiscard]] auto weights(N const& src, N const& dest) const -> std::vector<E> {
-			auto src_itor = nodes_.find(src);
-			auto dest_itor = nodes_.find(dest);
+		template<typename Src = N, typename Dest = N>
+			requires detail::node_key<Src, N> and detail::node_key<Dest, N>
+		[[nodiscard]] auto weights(Src const& src, Dest const& dest) const -> std::vector<E> {
+			auto src_itor = find_node_itor(src);
+			auto dest_itor = find_node_itor(dest);
 			if (src_itor == nodes_.end() or dest_itor == nodes_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights "
 				                         "if src or dst node don't exist in the graph");
 			};
+			return weights_by_id(node_id{&*src_itor}, node_id{&*dest_itor});
+		};
+
+		// One search of edges_ for the (src, dest) run: O(log e + k), whatever src's degree.
+		[[nodiscard]] auto weights_by_id(node_id src, node_id dest) const -> std::vector<E> {
 			auto weights = std::vector<E>();
-			std::for_each(edges_.begin(), edges_.end(), [&weights, &src_itor, &dest_itor](auto const& e) {
-				if (e.src == src_itor->value.get() and e.dest == dest_itor->value.get()) {
-					weights.push_back(*e.weight);
-				};
+			auto [first, last] = edges_.equal_range(src_dest_key{src.node_, dest.node_});
+			std::transform(first, last, std::back_inserter(weights), [](edge const& e) {
+				return e.weight;
 			});
 			return weights;
 		};
 
-		[[nodiscard]] auto find(N const& src, N const& dest, E const& weight) const -> iterator {
-			return iterator{edges_.find(value_type(src, dest, weight))};
+		template<typename Src = N, typename Dest = N>
+			requires detail::node_key<Src, N> and detail::node_key<Dest, N>
+		[[nodiscard]] auto find(Src const& src, Dest const& dest, E const& weight) const -> iterator {
+			if constexpr (detail::lookup_key<Src, N> and detail::lookup_key<Dest, N>) {
+				return iterator{edges_.find(value_key<Src, Dest>{src, dest, weight})};
+			}
+			else {
+				return find(as_lookup_key(src), as_lookup_key(dest), weight);
+			};
 		};
 
-		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
-			auto src_itor = nodes_.find(src);
+		template<typename K = N>
+			requires detail::node_key<K, N>
+		[[nodiscard]] auto connections(K const& src) const -> std::vector<N> {
+			auto src_itor = find_node_itor(src);
 			if (src_itor == nodes_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections "
 				                         "if src doesn't exist in the graph");
 			};
-			auto connections = std::set<N>();
-			std::for_each(edges_.begin(), edges_.end(), [&connections, &src_itor](auto const& e) {
-				if (e.src == src_itor->value.get()) {
-					connections.insert(*e.dest);
+			// Outgoing edges are sorted by destination, so duplicates are adjacent
+			auto [first, last] = edges_.equal_range(src_key{&*src_itor});
+			auto connections = std::vector<N>();
+			std::for_each(first, last, [&connections](edge const& e) {
+				if (connections.empty() or connections.back() < e.dest->value) {
+					connections.push_back(e.dest->value);
 				};
 			});
-			return std::vector<N>(connections.begin(), connections.end());
+			return connections;
+		};
+
+		// Ids of the nodes src has edges to, in the same order as connections(src). O(deg(src)).
+		[[nodiscard]] auto connections_by_id(node_id src) const -> std::vector<node_id> {
+			auto connections = std::vector<node_id>();
+			for (auto const* e = src.node_->out_head; e != nullptr; e = e->next_out) {
+				if (connections.empty() or connections.back().node_ != e->dest) {
+					connections.push_back(node_id{e->dest});
+				};
+			};
+			return connections;
+		};
+
+		template<typename K = N>
+			requires detail::node_key<K, N>
+		[[nodiscard]] auto find_node(K const& value) const -> std::optional<node_id> {
+			auto itor = find_node_itor(value);
+			return itor == nodes_.end() ? std::nullopt : std::optional<node_id>(node_id{&*itor});
+		};
+
+		[[nodiscard]] auto node_value(node_id id) const -> N const& {
+			return id.node_->value;
+		};
+
+		// Views: lazy ranges of references into the graph, the non-allocating counterparts of
+		// nodes(), weights() and connections(). Like iterators, they are invalidated by changes to
+		// what they refer to.
+		[[nodiscard]] auto nodes_view() const {
+			return std::views::transform(nodes_, &node::value);
+		};
+
+		template<typename Src = N, typename Dest = N>
+			requires detail::node_key<Src, N> and detail::node_key<Dest, N>
+		[[nodiscard]] auto weights_view(Src const& src, Dest const& dest) const {
+			auto src_itor = find_node_itor(src);
+			auto dest_itor = find_node_itor(dest);
+			if (src_itor == nodes_.end() or dest_itor == nodes_.end()) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights_view "
+				                         "if src or dst node don't exist in the graph");
+			};
+			// Searches edges_ for the start of the run of edges to dest, as weights_by_id does, then
+			// walks to its end on src's out-list: O(log e + k), whatever src's degree.
+			auto const run = edges_.lower_bound(src_dest_key{&*src_itor, &*dest_itor});
+			auto const* first = static_cast<edge const*>(nullptr);
+			if (run != edges_.end() and run->src == &*src_itor and run->dest == &*dest_itor) {
+				first = &*run;
+			};
+			auto const* last = first;
+			while (last != nullptr and last->dest == &*dest_itor) {
+				last = last->next_out;
+			};
+			return std::ranges::subrange(out_edge_iterator{first}, out_edge_iterator{last})
+			       | std::views::transform(&edge::weight);
+		};
+
+		template<typename K = N>
+			requires detail::node_key<K, N>
+		[[nodiscard]] auto connections_view(K const& src) const {
+			auto src_itor = find_node_itor(src);
+			if (src_itor == nodes_.end()) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections_view "
+				                         "if src doesn't exist in the graph");
+			};
+			// Keeps the first edge to each destination: the out-list follows edges_, so an edge
+			// repeats a destination exactly when the edge before it on the list has the same one.
+			auto first_to_dest = [](edge const& e) {
+				return e.prev_out == nullptr or e.prev_out->dest != e.dest;
+			};
+			return std::ranges::subrange(out_edge_iterator{src_itor->out_head}, out_edge_iterator{})
+			       | std::views::filter(first_to_dest)
+			       | std::views::transform([](edge const& e) -> N const& { return e.dest->value; });
 		};
 
 		// Iterator access
@@ -394,23 +923,397 @@ namespace gdwg {
 			return iterator{edges_.end()};
 		};
 
+		// Splits [begin(), end()) into k consecutive, disjoint ranges for parallel work. Each
+		// source's edges stay in one range, and every cut is placed at the source boundary nearest
+		// an even share of the edges, so ranges are as balanced as the out-degrees allow (some are
+		// empty when k exceeds the sources with edges). Costs O(n + k log e) and does not visit the
+		// edges.
+		[[nodiscard]] auto edge_partitions(std::size_t k) const
+		   -> std::vector<std::ranges::subrange<iterator>> {
+			if (k == 0) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::edge_partitions "
+				                         "with zero partitions");
+			};
+			auto cuts = std::vector<iterator>{begin()};
+			cuts.reserve(k + 1);
+			auto const total = edges_.size();
+			auto before = std::size_t{0};
+			for (auto itor = nodes_.begin(); itor != nodes_.end() and cuts.size() < k; ++itor) {
+				// Cut p goes before this node if the node's midpoint is at or past total * p / k.
+				auto const midpoint = 2 * before + itor->out_degree;
+				auto const due = [&] {
+					return cuts.size() < k and midpoint * k >= 2 * total * cuts.size();
+				};
+				if (due()) {
+					auto const first = iterator{edges_.lower_bound(src_key{&*itor})};
+					do {
+						cuts.push_back(first);
+					} while (due());
+				};
+				before += itor->out_degree;
+			};
+			cuts.resize(k, end());
+			cuts.push_back(end());
+			auto partitions = std::vector<std::ranges::subrange<iterator>>();
+			partitions.reserve(k);
+			for (auto p = std::size_t{0}; p < k; ++p) {
+				partitions.emplace_back(cuts[p], cuts[p + 1]);
+			};
+			return partitions;
+		};
+
 		// Comparisons
-		[[nodiscard]] auto operator==(graph const& other) const noexcept -> bool = default;
+		// Graphs with different hashes or sizes are told apart in O(1). Others are compared in
+		// O(n + e) by a single walk over both node sets in step, each node's out-list beside its
+		// counterpart's. Paired edges then have paired sources, so only their destinations and
+		// weights are compared, by value.
+		[[nodiscard]] auto operator==(graph const& other) const noexcept -> bool {
+			if (this == &other) {
+				return true;
+			};
+			if (hash_ != other.hash_ or nodes_.size() != other.nodes_.size()
+			    or edges_.size() != other.edges_.size())
+			{
+				return false;
+			};
+			return std::equal(nodes_.begin(), nodes_.end(), other.nodes_.begin(), same_node_and_edges);
+		};
 
 		// Extractor
+		// Writes straight to os in a single pass: edges_ is grouped by source in node order, so each
+		// node's edges are the run that starts where the previous node's ended.
 		friend auto operator<<(std::ostream& os, graph const& g) -> std::ostream& {
-			auto oss = std::ostringstream{};
-			std::for_each(g.nodes_.begin(), g.nodes_.end(), [&oss, &g](auto const& n) {
-				oss << *n.value << " (\n";
-				std::for_each(g.edges_.begin(), g.edges_.end(), [&oss, &n](auto const& e) {
-					if (e.src == n.value.get()) {
-						oss << "  " << *e.dest << " | " << *e.weight << "\n";
-					};
-				});
-				oss << ")\n";
+			auto itor = g.edges_.begin();
+			std::for_each(g.nodes_.begin(), g.nodes_.end(), [&os, &g, &itor](auto const& n) {
+				os << n.value << " (\n";
+				for (; itor != g.edges_.end() and itor->src == &n; ++itor) {
+					os << "  " << itor->dest->value << " | " << itor->weight << "\n";
+				};
+				os << ")\n";
 			});
-			return os << oss.str();
+			return os;
+		};
+
+	private:
+		// Copies orig into this (empty) graph in O(n + e). Both sets are already sorted, so every
+		// element is appended with an end hint. Edges are copied node by node along the out-lists, so
+		// the source's copy is at hand, and destinations are translated through a map from orig's
+		// nodes to their copies instead of being looked up by value.
+		auto clone_from(graph const& orig) -> void {
+			using node_map_value = std::pair<node const* const, node const*>;
+			auto copies = std::unordered_map<node const*,
+			                                 node const*,
+			                                 std::hash<node const*>,
+			                                 std::equal_to<>,
+			                                 rebind_alloc<node_map_value>>(orig.nodes_.size(),
+			                                                               get_allocator());
+			std::for_each(orig.nodes_.begin(), orig.nodes_.end(), [&](node const& n) {
+				copies.emplace(&n, &*emplace_node_hint(nodes_.end(), n.value));
+			});
+			auto src = nodes_.begin();
+			auto const* last = static_cast<edge const*>(nullptr);
+			std::for_each(orig.nodes_.begin(), orig.nodes_.end(), [&](node const& n) {
+				for (auto const* e = n.out_head; e != nullptr; e = e->next_out) {
+					auto const itor =
+					   edges_.emplace_hint(edges_.end(), &*src, copies[e->dest], e->weight);
+					auto const& copy = *itor;
+					copy.self = itor;
+					link_in(copy);
+					link_out(copy, last, nullptr);
+					last = &copy;
+				};
+				++src;
+			});
+		};
+
+		// Node holding value, checking itor and its successor before searching the whole set.
+		auto find_node_near(node_itor itor, N const& value) const -> node_itor {
+			for (auto i = 0; i < 2 and itor != nodes_.end(); ++i, ++itor) {
+				if (itor->value == value) {
+					return itor;
+				};
+			};
+			return find_node_itor(value);
+		};
+
+		template<typename K>
+		auto find_node_itor(K const& value) const -> node_itor {
+			if constexpr (not detail::lookup_key<K, N>) {
+				return find_node_itor(static_cast<N>(value));
+			}
+			else if constexpr (hashed) {
+				return index_.find(value, nodes_.end());
+			}
+			else {
+				return nodes_.find(value);
+			};
+		};
+
+		// value itself if nodes can be compared with it, or else value converted to N.
+		template<typename K>
+		static auto as_lookup_key(K const& value) -> decltype(auto) {
+			if constexpr (detail::lookup_key<K, N>) {
+				return (value);
+			}
+			else {
+				return static_cast<N>(value);
+			};
+		};
+
+		// Inserts value with a hint, indexing and hashing the node if it is new.
+		auto emplace_node_hint(node_itor hint, N const& value) -> node_itor {
+			if constexpr (hashed) {
+				index_.reserve_one();
+			};
+			auto const size = nodes_.size();
+			auto itor = nodes_.emplace_hint(hint, value);
+			if (nodes_.size() != size) {
+				itor->self = itor;
+				if constexpr (hashed) {
+					index_.insert(itor);
+				};
+				hash_ += itor->hash;
+			};
+			return itor;
+		};
+
+		// Removes a node, whose edges are already gone, from nodes_, the index and the hash.
+		auto erase_node_entry(node_itor itor) -> void {
+			if constexpr (hashed) {
+				index_.erase(itor);
+			};
+			hash_ -= itor->hash;
+			nodes_.erase(itor);
+		};
+
+		auto swap_contents(graph& other) noexcept -> void {
+			nodes_.swap(other.nodes_);
+			edges_.swap(other.edges_);
+			if constexpr (hashed) {
+				index_.swap(other.index_);
+			};
+			std::swap(hash_, other.hash_);
+		};
+
+		// Whether a and b, of different graphs, hold the same value and out-edges. Cached hashes
+		// are compared before values, and out-degrees before edges.
+		static auto same_node_and_edges(node const& a, node const& b) -> bool {
+			if (a.hash != b.hash or a.out_degree != b.out_degree or not(a.value == b.value)) {
+				return false;
+			};
+			auto const* f = b.out_head;
+			for (auto const* e = a.out_head; e != nullptr; e = e->next_out, f = f->next_out) {
+				if (e->dest->hash != f->dest->hash or not(e->dest->value == f->dest->value)
+				    or not(e->weight == f->weight))
+				{
+					return false;
+				};
+			};
+			return true;
+		};
+
+		static auto hash_node(N const& value) -> std::size_t {
+			if constexpr (content_hashed) {
+				return detail::mix_hash(std::hash<N>{}(value));
+			}
+			else {
+				return 0;
+			};
+		};
+
+		// Mixed at each step so that an edge's endpoints and weight count in order.
+		static auto hash_edge(edge const& e) -> std::size_t {
+			if constexpr (content_hashed) {
+				auto const weight = detail::mix_hash(std::hash<E>{}(e.weight));
+				return detail::mix_hash(e.src->hash + detail::mix_hash(e.dest->hash + weight));
+			}
+			else {
+				return 0;
+			};
+		};
+
+		static auto make_index(Alloc const& alloc) -> node_index {
+			if constexpr (hashed) {
+				return node_index(rebind_alloc<node_itor>(alloc));
+			}
+			else {
+				return node_index{};
+			};
+		};
+
+		// Adds a newly inserted edge to its destination's in-list and, next to its neighbours in
+		// edges_, to its source's out-list.
+		auto link(edge_itor itor) -> void {
+			auto const& e = *itor;
+			e.self = itor;
+			auto const* prev = itor != edges_.begin() ? &*std::prev(itor) : nullptr;
+			auto const* next = ++itor != edges_.end() ? &*itor : nullptr;
+			link_in(e);
+			link_out(e, prev, next);
+		};
+
+		// prev and next are e's neighbours in edges_, or null.
+		auto link_out(edge const& e, edge const* prev, edge const* next) -> void {
+			++e.src->out_degree;
+			hash_ += hash_edge(e);
+			if (prev != nullptr and prev->src == e.src) {
+				e.prev_out = prev;
+				prev->next_out = &e;
+			}
+			else {
+				e.src->out_head = &e;
+			};
+			if (next != nullptr and next->src == e.src) {
+				e.next_out = next;
+				next->prev_out = &e;
+			};
+		};
+
+		auto unlink(edge const& e) -> void {
+			unlink_in(e);
+			--e.src->out_degree;
+			hash_ -= hash_edge(e);
+			if (e.prev_out != nullptr) {
+				e.prev_out->next_out = e.next_out;
+			}
+			else {
+				e.src->out_head = e.next_out;
+			};
+			if (e.next_out != nullptr) {
+				e.next_out->prev_out = e.prev_out;
+			};
+			e.prev_out = nullptr;
+			e.next_out = nullptr;
+		};
+
+		auto link_in(edge const& e) -> void {
+			e.next_in = e.dest->in_head;
+			if (e.next_in != nullptr) {
+				e.next_in->prev_in = &e;
+			};
+			e.dest->in_head = &e;
+		};
+
+		auto unlink_in(edge const& e) -> void {
+			if (e.prev_in != nullptr) {
+				e.prev_in->next_in = e.next_in;
+			}
+			else {
+				e.dest->in_head = e.next_in;
+			};
+			if (e.next_in != nullptr) {
+				e.next_in->prev_in = e.prev_in;
+			};
+			e.prev_in = nullptr;
+			e.next_in = nullptr;
+		};
+
+		// Erases the node's edges straight off its out- and in-lists, without searching edges_.
+		auto erase_node_itor(node_itor itor) -> void {
+			while (itor->out_head != nullptr) {
+				erase_edge_itor(itor->out_head->self);
+			};
+			while (itor->in_head != nullptr) {
+				erase_edge_itor(itor->in_head->self);
+			};
+			erase_node_entry(itor);
+		};
+
+		auto erase_edge_itor(edge_itor itor) -> edge_itor {
+			unlink(*itor);
+			return edges_.erase(itor);
+		};
+
+		// An edge to erase, and its endpoints once they have been looked up.
+		struct edge_request {
+			value_type const* value;
+			node const* src;
+			node const* dest;
+		};
+
+		auto erase_edge_requests(std::vector<edge_request, rebind_alloc<edge_request>>& requests)
+		   -> std::size_t {
+			std::sort(requests.begin(), requests.end(), [](auto const& lhs, auto const& rhs) {
+				return std::tie(lhs.value->from, lhs.value->to, lhs.value->weight)
+				       < std::tie(rhs.value->from, rhs.value->to, rhs.value->weight);
+			});
+			// In sorted order a repeated source, or a repeated destination under the same source, is
+			// at (or next to) the node found for the request before it, so it is not searched for.
+			auto src_itor = nodes_.end();
+			auto dest_itor = nodes_.end();
+			for (auto& r : requests) {
+				src_itor = find_node_near(src_itor, r.value->from);
+				dest_itor = find_node_near(dest_itor, r.value->to);
+				if (src_itor == nodes_.end() or dest_itor == nodes_.end()) {
+					throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edges "
+					                         "on src or dst if they don't exist in the graph");
+				};
+				r.src = &*src_itor;
+				r.dest = &*dest_itor;
+			};
+
+			auto erased = std::size_t{0};
+			auto itor = edges_.end();
+			auto in_run = [&itor, this](edge_request const& r) {
+				return itor != edges_.end() and itor->src == r.src and itor->dest == r.dest;
+			};
+			for (auto const& r : requests) {
+				if (not in_run(r)) {
+					itor = edges_.lower_bound(src_dest_key{r.src, r.dest});
+				};
+				while (in_run(r) and itor->weight < r.value->weight) {
+					++itor;
+				};
+				if (in_run(r) and not(r.value->weight < itor->weight)) {
+					itor = erase_edge_itor(itor);
+					++erased;
+				};
+			};
+			return erased;
+		};
+
+		// Moves every edge touching old_node onto new_node, dropping edges that already exist there.
+		// Only the edges adjacent to old_node are visited: O(deg(old_node) log e).
+		auto retarget_edges(node const& old_node, node const& new_node) -> void {
+			auto retarget = [&](edge_itor itor) {
+				unlink(*itor);
+				auto handle = edges_.extract(itor);
+				auto& e = handle.value();
+				e.src = e.src == &old_node ? &new_node : e.src;
+				e.dest = e.dest == &old_node ? &new_node : e.dest;
+				return handle;
+			};
+			auto reinsert = [&](typename edge_set::node_type handle) {
+				auto result = edges_.insert(std::move(handle));
+				if (result.inserted) {
+					link(result.position);
+				};
+			};
+			// Outgoing edges (including self-loops). Reinserted edges have a different source, so they
+			// never land between the current edge and the next one still to be visited.
+			auto itor = edges_.lower_bound(src_key{&old_node});
+			while (itor != edges_.end() and itor->src == &old_node) {
+				reinsert(retarget(itor++));
+			};
+			// Only incoming edges from other nodes remain on old_node's list.
+			while (old_node.in_head != nullptr) {
+				reinsert(retarget(edges_.find(*old_node.in_head)));
+			};
 		};
 	};
+
+	namespace pmr {
+		template<typename N, typename E, typename Index = ordered_index>
+		using graph = gdwg::graph<N, E, std::pmr::polymorphic_allocator<std::byte>, Index>;
+	} // namespace pmr
 } // namespace gdwg
+
+// Equal graphs have equal hashes, however they were built.
+template<typename N, typename E, typename Alloc, typename Index>
+	requires gdwg::detail::hashable<N> and gdwg::detail::hashable<E>
+struct std::hash<gdwg::graph<N, E, Alloc, Index>> {
+	auto operator()(gdwg::graph<N, E, Alloc, Index> const& g) const noexcept -> std::size_t {
+		return g.hash_;
+	};
+};
 #endif // GDWG_GRAPH_HPP
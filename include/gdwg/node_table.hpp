@@ -0,0 +1,202 @@
+#ifndef GDWG_NODE_TABLE_HPP
+#define GDWG_NODE_TABLE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg::detail {
+	// The string view type of a std::basic_string, which std::hash agrees with.
+	template<typename T>
+	struct string_view_of {};
+
+	template<typename CharT, typename Traits, typename Alloc>
+	struct string_view_of<std::basic_string<CharT, Traits, Alloc>> {
+		using type = std::basic_string_view<CharT, Traits>;
+	};
+
+	// Flat open-addressing hash table of iterators to nodes, keyed by the node's value, for
+	// gdwg::hashed_index. Slots are probed linearly. Next to each slot is a tag byte holding 7 bits
+	// of the value's hash, so a probe only compares values whose tags match; erased slots become
+	// tombstones until the next rehash. The table never owns the nodes it points at.
+	template<typename N, typename Itor, typename Alloc>
+	class node_table {
+	public:
+		explicit node_table(Alloc const& alloc)
+		: slots_(alloc)
+		, tags_(alloc) {}
+
+		// Moves leave the source empty, like the node set they index.
+		node_table(node_table&& orig) noexcept
+		: slots_(std::move(orig.slots_))
+		, tags_(std::move(orig.tags_))
+		, size_{std::exchange(orig.size_, 0)}
+		, tombstones_{std::exchange(orig.tombstones_, 0)}
+		, shift_{std::exchange(orig.shift_, 64)} {
+			orig.slots_.clear();
+			orig.tags_.clear();
+		};
+
+		auto operator=(node_table&& orig) -> node_table& {
+			slots_ = std::move(orig.slots_);
+			tags_ = std::move(orig.tags_);
+			size_ = std::exchange(orig.size_, 0);
+			tombstones_ = std::exchange(orig.tombstones_, 0);
+			shift_ = std::exchange(orig.shift_, 64);
+			orig.slots_.clear();
+			orig.tags_.clear();
+			return *this;
+		};
+
+		node_table(node_table const& orig) = delete;
+		auto operator=(node_table const& orig) -> node_table& = delete;
+		~node_table() = default;
+
+		auto swap(node_table& other) noexcept -> void {
+			slots_.swap(other.slots_);
+			tags_.swap(other.tags_);
+			std::swap(size_, other.size_);
+			std::swap(tombstones_, other.tombstones_);
+			std::swap(shift_, other.shift_);
+		};
+
+		// Makes room for one more node, so that the insert that follows can't throw.
+		auto reserve_one() -> void {
+			if ((size_ + tombstones_ + 1) * 4 > tags_.size() * 3) {
+				rehash();
+			};
+		};
+
+		// The node holding value, or not_found. value may be any key that compares equal to N.
+		template<typename K>
+		[[nodiscard]] auto find(K const& value, Itor not_found) const -> Itor {
+			if (size_ == 0) {
+				return not_found;
+			};
+			auto const h = hash(value);
+			for (auto i = home(h); tags_[i] != empty; i = (i + 1) & mask()) {
+				if (tags_[i] == tag(h) and slots_[i]->value == value) {
+					return slots_[i];
+				};
+			};
+			return not_found;
+		};
+
+		// Adds a node that isn't in the table yet. Needs a preceding reserve_one.
+		auto insert(Itor itor) noexcept -> void {
+			auto const h = hash(itor->value);
+			auto i = home(h);
+			while (tags_[i] >= full) {
+				i = (i + 1) & mask();
+			};
+			tombstones_ -= tags_[i] == tombstone ? 1 : 0;
+			tags_[i] = tag(h);
+			slots_[i] = itor;
+			++size_;
+		};
+
+		auto erase(Itor itor) noexcept -> void {
+			auto const h = hash(itor->value);
+			auto i = home(h);
+			while (not(tags_[i] == tag(h) and &*slots_[i] == &*itor)) {
+				i = (i + 1) & mask();
+			};
+			// A slot followed by an empty one ends no probe sequence, so it can be emptied outright.
+			if (tags_[(i + 1) & mask()] == empty) {
+				tags_[i] = empty;
+			}
+			else {
+				tags_[i] = tombstone;
+				++tombstones_;
+			};
+			--size_;
+		};
+
+		auto clear() noexcept -> void {
+			std::fill(tags_.begin(), tags_.end(), empty);
+			size_ = 0;
+			tombstones_ = 0;
+		};
+
+	private:
+		static constexpr auto empty = std::uint8_t{0};
+		static constexpr auto tombstone = std::uint8_t{1};
+		static constexpr auto full = std::uint8_t{0x80};
+		static constexpr auto min_capacity = std::size_t{16};
+
+		using tag_alloc = typename std::allocator_traits<Alloc>::template rebind_alloc<std::uint8_t>;
+
+		std::vector<Itor, Alloc> slots_;
+		std::vector<std::uint8_t, tag_alloc> tags_;
+		std::size_t size_ = 0;
+		std::size_t tombstones_ = 0;
+		int shift_ = 64;
+
+		// Fibonacci hashing: the multiply spreads weak hashes such as the identity std::hash<int>
+		// over the high bits, which pick the slot, and the low bits make the tag.
+		template<typename K>
+		static auto hash(K const& value) -> std::uint64_t {
+			return static_cast<std::uint64_t>(hash_of(value)) * 0x9e3779b97f4a7c15U;
+		};
+
+		// std::hash<N> of the N equal to value. Strings hash the same as their views, so keys that
+		// convert to a view of N are hashed as one; any other key is converted to N.
+		template<typename K>
+		static auto hash_of(K const& value) -> std::size_t {
+			if constexpr (std::is_same_v<K, N>) {
+				return std::hash<N>{}(value);
+			}
+			else if constexpr (requires { typename string_view_of<N>::type; }
+			                   and std::is_convertible_v<K const&, typename string_view_of<N>::type>)
+			{
+				using view = typename string_view_of<N>::type;
+				return std::hash<view>{}(view(value));
+			}
+			else {
+				return std::hash<N>{}(static_cast<N>(value));
+			};
+		};
+
+		auto home(std::uint64_t h) const -> std::size_t {
+			return static_cast<std::size_t>(h >> shift_);
+		};
+
+		static auto tag(std::uint64_t h) -> std::uint8_t {
+			return static_cast<std::uint8_t>(full | (h & 0x7f));
+		};
+
+		auto mask() const -> std::size_t {
+			return tags_.size() - 1;
+		};
+
+		// Drops the tombstones and grows the table to at most half full with one more node.
+		auto rehash() -> void {
+			auto capacity = min_capacity;
+			auto shift = 64 - 4;
+			while (capacity < 2 * (size_ + 1)) {
+				capacity *= 2;
+				--shift;
+			};
+			auto slots = decltype(slots_)(capacity, slots_.get_allocator());
+			auto tags = decltype(tags_)(capacity, empty, tags_.get_allocator());
+			std::swap(slots, slots_);
+			std::swap(tags, tags_);
+			shift_ = shift;
+			size_ = 0;
+			tombstones_ = 0;
+			for (auto i = std::size_t{0}; i < tags.size(); ++i) {
+				if (tags[i] >= full) {
+					insert(slots[i]);
+				};
+			};
+		};
+	};
+} // namespace gdwg::detail
+#endif // GDWG_NODE_TABLE_HPP
@@ -0,0 +1,275 @@
+#ifndef GDWG_PARSE_GRAPH_HPP
+#define GDWG_PARSE_GRAPH_HPP
+
+#include <gdwg/graph.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Reading graphs back from text. Input is pulled from the stream buffer in large chunks and split
+// in place, and arithmetic values are converted with std::from_chars, so nothing is copied or
+// parsed through an istream per line or per value.
+namespace gdwg {
+	enum class graph_format {
+		// What operator<< writes: "value (" on its own line, one "  dest | weight" line per edge,
+		// then ")". A string value is everything before the final " (" of its line; an edge's
+		// destination is everything before the last " | ".
+		adjacency,
+		// Whitespace-separated "src dest weight" triples; every endpoint becomes a node.
+		edge_list,
+	};
+
+	namespace detail {
+		// Hands out lines or whitespace-separated tokens as views into a buffer that is refilled
+		// from the stream buffer chunk by chunk. A view is only valid until the next call.
+		class chunked_reader {
+		public:
+			explicit chunked_reader(std::istream& is, std::size_t chunk_size = std::size_t{1} << 20)
+			: is_{is}
+			, buffer_(chunk_size) {}
+
+			// The next line without its '\n'; the last line needs no terminator.
+			auto next_line() -> std::optional<std::string_view> {
+				auto scanned = pos_;
+				while (true) {
+					auto const* newline = static_cast<char const*>(
+					   std::memchr(buffer_.data() + scanned, '\n', end_ - scanned));
+					if (newline != nullptr) {
+						auto const length = static_cast<std::size_t>(newline - (buffer_.data() + pos_));
+						last_line_ = line_++;
+						return take(length, length + 1);
+					};
+					auto const unconsumed = end_ - pos_;
+					if (not refill()) {
+						last_line_ = line_;
+						if (unconsumed == 0) {
+							return std::nullopt;
+						};
+						return take(unconsumed, unconsumed);
+					};
+					scanned = pos_ + unconsumed;
+				};
+			};
+
+			// The next run of non-whitespace characters.
+			auto next_token() -> std::optional<std::string_view> {
+				while (true) {
+					while (pos_ != end_ and is_space(buffer_[pos_])) {
+						line_ += buffer_[pos_] == '\n' ? 1 : 0;
+						++pos_;
+					};
+					if (pos_ != end_) {
+						break;
+					};
+					if (not refill()) {
+						return std::nullopt;
+					};
+				};
+				last_line_ = line_;
+				auto length = std::size_t{0};
+				while (true) {
+					while (pos_ + length != end_ and not is_space(buffer_[pos_ + length])) {
+						++length;
+					};
+					if (pos_ + length != end_ or not refill()) {
+						return take(length, length);
+					};
+				};
+			};
+
+			// 1-based line of the most recently returned line or token.
+			[[nodiscard]] auto line() const -> std::size_t {
+				return last_line_;
+			};
+
+		private:
+			std::istream& is_;
+			std::vector<char> buffer_;
+			std::size_t pos_ = 0;
+			std::size_t end_ = 0;
+			std::size_t line_ = 1;
+			std::size_t last_line_ = 0;
+
+			static auto is_space(char c) -> bool {
+				return c == ' ' or c == '\n' or c == '\t' or c == '\r' or c == '\v' or c == '\f';
+			};
+
+			// Returns the next length characters and consumes `consumed` of them.
+			auto take(std::size_t length, std::size_t consumed) -> std::string_view {
+				auto const view = std::string_view(buffer_.data() + pos_, length);
+				pos_ += consumed;
+				return view;
+			};
+
+			// Moves the unconsumed tail to the front, growing the buffer if the tail fills it, and
+			// reads another chunk after it. False once the stream is exhausted.
+			auto refill() -> bool {
+				std::memmove(buffer_.data(), buffer_.data() + pos_, end_ - pos_);
+				end_ -= pos_;
+				pos_ = 0;
+				if (end_ == buffer_.size()) {
+					buffer_.resize(buffer_.size() * 2);
+				};
+				auto const space = static_cast<std::streamsize>(buffer_.size() - end_);
+				auto const read = is_.rdbuf()->sgetn(buffer_.data() + end_, space);
+				if (read <= 0) {
+					is_.setstate(std::ios_base::eofbit);
+					return false;
+				};
+				end_ += static_cast<std::size_t>(read);
+				return true;
+			};
+		};
+
+		[[noreturn]] inline auto malformed(std::size_t line) -> void {
+			throw std::runtime_error("Cannot call gdwg::parse_graph on malformed input at line "
+			                         + std::to_string(line));
+		};
+
+		// Converts the whole of text to a T, or nothing if it isn't one.
+		template<typename T>
+		auto parse_value(std::string_view text) -> std::optional<T> {
+			if constexpr (std::is_same_v<T, char>) {
+				return text.size() == 1 ? std::optional<T>(text.front()) : std::nullopt;
+			}
+			else if constexpr (std::is_arithmetic_v<T> and not std::is_same_v<T, bool>) {
+				auto value = T{};
+				auto const* last = text.data() + text.size();
+				auto const [ptr, ec] = std::from_chars(text.data(), last, value);
+				return ec == std::errc{} and ptr == last ? std::optional<T>(value) : std::nullopt;
+			}
+			else if constexpr (std::is_constructible_v<T, std::string_view>) {
+				return T(text);
+			}
+			else {
+				auto in = std::istringstream(std::string(text));
+				auto value = T{};
+				return in >> value and (in >> std::ws).eof() ? std::optional<T>(std::move(value))
+				                                              : std::nullopt;
+			};
+		};
+
+		template<typename T>
+		auto parse_value(std::string_view text, chunked_reader const& reader) -> T {
+			auto value = parse_value<T>(text);
+			if (not value) {
+				malformed(reader.line());
+			};
+			return std::move(*value);
+		};
+	} // namespace detail
+
+	// Reads a whole graph in the given format from the rest of is.
+	template<typename N,
+	         typename E,
+	         typename Alloc = std::allocator<std::byte>,
+	         typename Index = ordered_index>
+	auto parse_graph(std::istream& is,
+	                 graph_format format = graph_format::adjacency,
+	                 Alloc const& alloc = Alloc()) -> graph<N, E, Alloc, Index> {
+		using value_type = typename graph<N, E, Alloc, Index>::value_type;
+		auto reader = detail::chunked_reader(is);
+		auto nodes = std::vector<N>();
+		auto edges = std::vector<value_type>();
+
+		if (format == graph_format::adjacency) {
+			auto in_node = false;
+			while (auto line = reader.next_line()) {
+				if (not in_node) {
+					if (line->empty()) {
+						continue;
+					};
+					if (not line->ends_with(" (")) {
+						detail::malformed(reader.line());
+					};
+					nodes.push_back(detail::parse_value<N>(line->substr(0, line->size() - 2), reader));
+					in_node = true;
+				}
+				else if (*line == ")") {
+					in_node = false;
+				}
+				else {
+					auto const separator = line->rfind(" | ");
+					if (not line->starts_with("  ") or separator == std::string_view::npos
+					    or separator < 2) {
+						detail::malformed(reader.line());
+					};
+					auto to = detail::parse_value<N>(line->substr(2, separator - 2), reader);
+					auto weight = detail::parse_value<E>(line->substr(separator + 3), reader);
+					edges.push_back(value_type{nodes.back(), std::move(to), std::move(weight)});
+				};
+			};
+			if (in_node) {
+				detail::malformed(reader.line());
+			};
+		}
+		else {
+			while (auto src = reader.next_token()) {
+				auto from = detail::parse_value<N>(*src, reader);
+				auto const dest = reader.next_token();
+				if (not dest) {
+					detail::malformed(reader.line());
+				};
+				auto to = detail::parse_value<N>(*dest, reader);
+				auto const weight = reader.next_token();
+				if (not weight) {
+					detail::malformed(reader.line());
+				};
+				auto value = detail::parse_value<E>(*weight, reader);
+				edges.push_back(value_type{std::move(from), std::move(to), std::move(value)});
+			};
+			// Sorted edges skip the tree searches and most node lookups; see graph::insert_edges.
+			auto const by_value = [](value_type const& a, value_type const& b) {
+				return std::tie(a.from, a.to, a.weight) < std::tie(b.from, b.to, b.weight);
+			};
+			if (not std::is_sorted(edges.begin(), edges.end(), by_value)) {
+				std::sort(edges.begin(), edges.end(), by_value);
+			};
+			nodes.reserve(2 * edges.size());
+			std::for_each(edges.begin(), edges.end(), [&nodes](value_type const& e) {
+				nodes.push_back(e.from);
+				nodes.push_back(e.to);
+			});
+			std::sort(nodes.begin(), nodes.end());
+			nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+		};
+
+		auto g = graph<N, E, Alloc, Index>(nodes.begin(), nodes.end(), alloc);
+		try {
+			g.insert_edges(edges.begin(), edges.end());
+		} catch (std::runtime_error const&) {
+			throw std::runtime_error("Cannot call gdwg::parse_graph when an edge's destination "
+			                         "is not a node of the graph");
+		};
+		return g;
+	};
+
+	// Replaces g with the graph read, in operator<<'s format, from the rest of is. On malformed
+	// input g is left unchanged and failbit is set.
+	template<typename N, typename E, typename Alloc, typename Index>
+	auto operator>>(std::istream& is, graph<N, E, Alloc, Index>& g) -> std::istream& {
+		auto const sentry = std::istream::sentry(is, true);
+		if (not sentry) {
+			return is;
+		};
+		try {
+			g = parse_graph<N, E, Alloc, Index>(is, graph_format::adjacency, g.get_allocator());
+		} catch (std::runtime_error const&) {
+			is.setstate(std::ios_base::failbit);
+		};
+		return is;
+	};
+} // namespace gdwg
+#endif // GDWG_PARSE_GRAPH_HPP
@@ -0,0 +1,432 @@
+#ifndef GDWG_PERSISTENT_GRAPH_HPP
+#define GDWG_PERSISTENT_GRAPH_HPP
+
+#include <gdwg/graph.hpp>
+#include <gdwg/persistent_tree.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// A graph whose copies are O(1) and independent. Every version of the graph is immutable
+	// underneath: a copy shares all of it, and a modification rebuilds only the tree paths it
+	// touches, so a version costs memory only for what changed since the version it was copied
+	// from. Keeping thousands of versions for rollback is cheap, and versions can be read from
+	// several threads at once (modifying one is not thread-safe, as with graph).
+	//
+	// Nodes are kept in a persistent_tree keyed on value. Each node holds persistent trees of its
+	// outgoing edges, as (dest, weight), and of its incoming edges, as (src, weight), so each
+	// edge is stored twice. insert_edge and erase_edge take O(log n + log deg) and allocate as
+	// many tree nodes; erase_node and the replacements are O(deg log n). Lookups are a constant
+	// factor slower than graph's.
+	//
+	// The interface is graph's, less the id and allocator extensions. Modifiers give the strong
+	// exception guarantee.
+	template<typename N, typename E>
+	class persistent_graph {
+	public:
+		using value_type = typename graph<N, E>::value_type;
+
+	private:
+		// One end of an edge: the node at the other end, and the weight.
+		struct edge_end {
+			N node;
+			E weight;
+
+			auto operator==(edge_end const& other) const -> bool = default;
+		};
+
+		// Orders edge ends by node then weight, and compares them to a bare node for range queries.
+		struct edge_end_cmp {
+			using is_transparent = std::true_type;
+			auto operator()(edge_end const& lhs, edge_end const& rhs) const -> bool {
+				return std::tie(lhs.node, lhs.weight) < std::tie(rhs.node, rhs.weight);
+			};
+			auto operator()(edge_end const& lhs, N const& rhs) const -> bool {
+				return lhs.node < rhs;
+			};
+			auto operator()(N const& lhs, edge_end const& rhs) const -> bool {
+				return lhs < rhs.node;
+			};
+		};
+
+		using edge_set = detail::persistent_tree<edge_end, edge_end_cmp>;
+
+		struct node {
+			N value;
+			edge_set out;
+			edge_set in;
+
+			// in is implied by the out sets of all the nodes
+			auto operator==(node const& other) const -> bool {
+				return value == other.value and out == other.out;
+			};
+		};
+
+		struct node_cmp {
+			using is_transparent = std::true_type;
+			auto operator()(node const& lhs, node const& rhs) const -> bool {
+				return lhs.value < rhs.value;
+			};
+			auto operator()(node const& lhs, N const& rhs) const -> bool {
+				return lhs.value < rhs;
+			};
+			auto operator()(N const& lhs, node const& rhs) const -> bool {
+				return lhs < rhs.value;
+			};
+		};
+
+		using node_set = detail::persistent_tree<node, node_cmp>;
+
+	public:
+		// Iterates over edges ordered by (from, to, weight), like graph's iterator. It keeps the
+		// version it came from alive, so it stays valid whatever later happens to that graph, and
+		// goes on iterating over that version.
+		class iterator {
+		public:
+			using value_type = persistent_graph::value_type;
+			using reference = value_type;
+			using pointer = void;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			iterator() = default;
+
+			auto operator*() const -> reference {
+				return value_type(node_->value, edge_->node, edge_->weight);
+			};
+
+			auto operator++() -> iterator& {
+				++edge_;
+				skip_empty();
+				return *this;
+			};
+
+			auto operator++(int) -> iterator {
+				auto tmp = *this;
+				++(*this);
+				return tmp;
+			};
+
+			auto operator==(iterator const& other) const -> bool {
+				return node_ == other.node_ and edge_ == other.edge_;
+			};
+
+		private:
+			typename node_set::iterator node_;
+			typename node_set::iterator node_end_;
+			typename edge_set::iterator edge_;
+
+			iterator(typename node_set::iterator node,
+			         typename node_set::iterator node_end,
+			         typename edge_set::iterator edge)
+			: node_{std::move(node)}
+			, node_end_{std::move(node_end)}
+			, edge_{std::move(edge)} {};
+
+			// Moves on to the first edge of the next node that has one, if edge_ has run out.
+			auto skip_empty() -> void {
+				while (edge_ == node_->out.end()) {
+					if (++node_ == node_end_) {
+						return;
+					};
+					edge_ = node_->out.begin();
+				};
+			};
+
+			friend class persistent_graph;
+		};
+
+		// Constructors
+		persistent_graph() = default;
+
+		persistent_graph(std::initializer_list<N> il)
+		: persistent_graph(il.begin(), il.end()) {}
+
+		template<typename InputIt>
+		persistent_graph(InputIt first, InputIt last) {
+			std::for_each(first, last, [this](N const& value) { insert_node(value); });
+		};
+
+		template<typename Alloc, typename Index>
+		explicit persistent_graph(graph<N, E, Alloc, Index> const& g) {
+			for (auto const& value : g.nodes()) {
+				insert_node(value);
+			};
+			for (auto const& [from, to, weight] : g) {
+				insert_edge(from, to, weight);
+			};
+		};
+
+		// Copies share everything, in O(1).
+		persistent_graph(persistent_graph const&) = default;
+		auto operator=(persistent_graph const&) -> persistent_graph& = default;
+		persistent_graph(persistent_graph&&) noexcept = default;
+		auto operator=(persistent_graph&&) noexcept -> persistent_graph& = default;
+		~persistent_graph() = default;
+
+		// Modifiers
+		auto insert_node(N const& value) -> bool {
+			return nodes_.insert(node{value, {}, {}});
+		};
+
+		auto insert_edge(N const& src, N const& dest, E const& weight) -> bool {
+			auto const* src_node = nodes_.find(src);
+			auto const* dest_node = nodes_.find(dest);
+			if (src_node == nullptr or dest_node == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::persistent_graph<N, E>::insert_edge "
+				                         "when either src or dst node does not exist");
+			};
+			auto out = src_node->out;
+			if (not out.insert(edge_end{dest, weight})) {
+				return false;
+			};
+			auto nodes = nodes_;
+			nodes.insert_or_assign(node{src, std::move(out), src_node->in});
+			auto const* updated = nodes.find(dest);
+			auto in = updated->in;
+			in.insert(edge_end{src, weight});
+			nodes.insert_or_assign(node{dest, updated->out, std::move(in)});
+			nodes_ = std::move(nodes);
+			return true;
+		};
+
+		auto replace_node(N const& old_data, N const& new_data) -> bool {
+			if (not is_node(old_data)) {
+				throw std::runtime_error("Cannot call gdwg::persistent_graph<N, E>::replace_node "
+				                         "on a node that doesn't exist");
+			};
+			if (is_node(new_data)) {
+				return false;
+			};
+			auto g = *this;
+			g.insert_node(new_data);
+			g.retarget_edges(old_data, new_data);
+			*this = std::move(g);
+			return true;
+		};
+
+		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
+			if (not is_node(old_data) or not is_node(new_data)) {
+				throw std::runtime_error("Cannot call gdwg::persistent_graph<N, E>::"
+				                         "merge_replace_node on old or new data if they don't exist "
+				                         "in the graph");
+			};
+			if (old_data == new_data) {
+				return;
+			};
+			auto g = *this;
+			g.retarget_edges(old_data, new_data);
+			*this = std::move(g);
+		};
+
+		auto erase_node(N const& value) -> bool {
+			auto const* n = nodes_.find(value);
+			if (n == nullptr) {
+				return false;
+			};
+			auto nodes = nodes_;
+			// Drop the far end of every edge, visiting each neighbour once: edge ends are sorted by
+			// neighbour. Self-loops vanish with the node itself.
+			for_each_neighbour(n->out, value, [&](N const& dest, auto first, auto last) {
+				auto const& d = *nodes.find(dest);
+				auto in = d.in;
+				std::for_each(first, last, [&](edge_end const& e) {
+					in.erase(edge_end{value, e.weight});
+				});
+				nodes.insert_or_assign(node{d.value, d.out, std::move(in)});
+			});
+			for_each_neighbour(n->in, value, [&](N const& src, auto first, auto last) {
+				auto const& s = *nodes.find(src);
+				auto out = s.out;
+				std::for_each(first, last, [&](edge_end const& e) {
+					out.erase(edge_end{value, e.weight});
+				});
+				nodes.insert_or_assign(node{s.value, std::move(out), s.in});
+			});
+			nodes.erase(value);
+			nodes_ = std::move(nodes);
+			return true;
+		};
+
+		auto erase_edge(N const& src, N const& dest, E const& weight) -> bool {
+			auto const* src_node = nodes_.find(src);
+			auto const* dest_node = nodes_.find(dest);
+			if (src_node == nullptr or dest_node == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::persistent_graph<N, E>::erase_edge "
+				                         "on src or dst if they don't exist in the graph");
+			};
+			auto out = src_node->out;
+			if (not out.erase(edge_end{dest, weight})) {
+				return false;
+			};
+			auto nodes = nodes_;
+			nodes.insert_or_assign(node{src, std::move(out), src_node->in});
+			auto const* updated = nodes.find(dest);
+			auto in = updated->in;
+			in.erase(edge_end{src, weight});
+			nodes.insert_or_assign(node{dest, updated->out, std::move(in)});
+			nodes_ = std::move(nodes);
+			return true;
+		};
+
+		auto clear() noexcept -> void {
+			nodes_.clear();
+		};
+
+		// Accessors
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return nodes_.find(value) != nullptr;
+		};
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return nodes_.empty();
+		};
+
+		[[nodiscard]] auto is_connected(N const& src, N const& dest) const -> bool {
+			auto const* src_node = nodes_.find(src);
+			if (src_node == nullptr or not is_node(dest)) {
+				throw std::runtime_error("Cannot call gdwg::persistent_graph<N, E>::is_connected "
+				                         "if src or dst node don't exist in the graph");
+			};
+			auto itor = src_node->out.lower_bound(dest);
+			return itor != src_node->out.end() and itor->node == dest;
+		};
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			auto nodes = std::vector<N>();
+			nodes.reserve(nodes_.size());
+			std::transform(nodes_.begin(), nodes_.end(), std::back_inserter(nodes), [](node const& n) {
+				return n.value;
+			});
+			return nodes;
+		};
+
+		[[nodiscard]] auto weights(N const& src, N const& dest) const -> std::vector<E> {
+			auto const* src_node = nodes_.find(src);
+			if (src_node == nullptr or not is_node(dest)) {
+				throw std::runtime_error("Cannot call gdwg::persistent_graph<N, E>::weights "
+				                         "if src or dst node don't exist in the graph");
+			};
+			auto weights = std::vector<E>();
+			for (auto itor = src_node->out.lower_bound(dest);
+			     itor != src_node->out.end() and itor->node == dest;
+			     ++itor)
+			{
+				weights.push_back(itor->weight);
+			};
+			return weights;
+		};
+
+		[[nodiscard]] auto find(N const& src, N const& dest, E const& weight) const -> iterator {
+			auto node_itor = nodes_.lower_bound(src);
+			if (node_itor == nodes_.end() or node_itor->value != src) {
+				return end();
+			};
+			auto const key = edge_end{dest, weight};
+			auto edge_itor = node_itor->out.lower_bound(key);
+			if (edge_itor == node_itor->out.end() or not(*edge_itor == key)) {
+				return end();
+			};
+			return iterator(std::move(node_itor), nodes_.end(), std::move(edge_itor));
+		};
+
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto const* src_node = nodes_.find(src);
+			if (src_node == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::persistent_graph<N, E>::connections "
+				                         "if src doesn't exist in the graph");
+			};
+			auto connections = std::vector<N>();
+			for (auto const& e : src_node->out) {
+				if (connections.empty() or connections.back() < e.node) {
+					connections.push_back(e.node);
+				};
+			};
+			return connections;
+		};
+
+		// A graph with the same nodes and edges, loaded in sorted order (see graph::insert_edges).
+		[[nodiscard]] auto to_graph() const -> graph<N, E> {
+			auto const nodes = this->nodes();
+			return graph<N, E>(nodes.begin(), nodes.end(), begin(), end());
+		};
+
+		// Iterator access
+		[[nodiscard]] auto begin() const -> iterator {
+			if (nodes_.empty()) {
+				return end();
+			};
+			auto node_itor = nodes_.begin();
+			auto edge_itor = node_itor->out.begin();
+			auto itor = iterator(std::move(node_itor), nodes_.end(), std::move(edge_itor));
+			itor.skip_empty();
+			return itor;
+		};
+
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(nodes_.end(), nodes_.end(), {});
+		};
+
+		// Comparisons
+		// Parts the two versions still share are not compared.
+		[[nodiscard]] auto operator==(persistent_graph const& other) const -> bool {
+			return nodes_ == other.nodes_;
+		};
+
+		// Extractor
+		friend auto operator<<(std::ostream& os, persistent_graph const& g) -> std::ostream& {
+			for (auto const& n : g.nodes_) {
+				os << n.value << " (\n";
+				for (auto const& e : n.out) {
+					os << "  " << e.node << " | " << e.weight << "\n";
+				};
+				os << ")\n";
+			};
+			return os;
+		};
+
+	private:
+		node_set nodes_;
+
+		// Calls f(neighbour, first, last) for each run [first, last) of ends in edges that share a
+		// neighbour other than self.
+		template<typename F>
+		static auto for_each_neighbour(edge_set const& edges, N const& self, F f) -> void {
+			for (auto first = edges.begin(); first != edges.end();) {
+				auto last = first;
+				while (last != edges.end() and last->node == first->node) {
+					++last;
+				};
+				if (first->node != self) {
+					f(first->node, first, last);
+				};
+				first = std::move(last);
+			};
+		};
+
+		// Moves every edge of old_data onto new_data, which must exist, and erases old_data. Edges
+		// that new_data already has are merged.
+		auto retarget_edges(N const& old_data, N const& new_data) -> void {
+			auto const old_node = *nodes_.find(old_data);
+			erase_node(old_data);
+			for (auto const& e : old_node.out) {
+				insert_edge(new_data, e.node == old_data ? new_data : e.node, e.weight);
+			};
+			for (auto const& e : old_node.in) {
+				if (e.node != old_data) {
+					insert_edge(e.node, new_data, e.weight);
+				};
+			};
+		};
+	};
+} // namespace gdwg
+#endif // GDWG_PERSISTENT_GRAPH_HPP
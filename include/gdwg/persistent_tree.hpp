@@ -0,0 +1,269 @@
+#ifndef GDWG_PERSISTENT_TREE_HPP
+#define GDWG_PERSISTENT_TREE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace gdwg::detail {
+	// Immutable AVL tree of T ordered by the transparent comparator Compare, shared between
+	// copies. Copying a tree copies one pointer. A modification builds new nodes only along the
+	// path from the root to the element it touches (plus the rotations that rebalance it) and
+	// points them at the untouched subtrees of the old tree, so the old tree, and every copy of
+	// it, stays as it was: O(log n) time and new memory per change. Nodes are reference-counted,
+	// so they go away with the last tree that uses them, and trees can be read from several
+	// threads at once.
+	template<typename T, typename Compare>
+	class persistent_tree {
+		struct node;
+		using node_ptr = std::shared_ptr<node const>;
+
+		struct node {
+			T value;
+			node_ptr left;
+			node_ptr right;
+			int height;
+		};
+
+	public:
+		// In-order iterator. It holds the root of the tree it came from, so the tree's nodes, and
+		// the iterator, stay valid whatever later happens to that tree.
+		class iterator {
+		public:
+			using value_type = T;
+			using reference = T const&;
+			using pointer = T const*;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			iterator() = default;
+
+			auto operator*() const -> reference {
+				return path_.back()->value;
+			};
+
+			auto operator->() const -> pointer {
+				return &path_.back()->value;
+			};
+
+			auto operator++() -> iterator& {
+				auto const* next = path_.back()->right.get();
+				path_.pop_back();
+				descend_left(next);
+				return *this;
+			};
+
+			auto operator++(int) -> iterator {
+				auto tmp = *this;
+				++(*this);
+				return tmp;
+			};
+
+			auto operator==(iterator const& other) const -> bool {
+				return path_.empty() ? other.path_.empty()
+				                     : not other.path_.empty() and path_.back() == other.path_.back();
+			};
+
+		private:
+			// Keeps the nodes on path_ alive.
+			node_ptr root_;
+			// Ancestors still to be visited, each above its left subtree; the current node last.
+			std::vector<node const*> path_;
+
+			auto descend_left(node const* n) -> void {
+				for (; n != nullptr; n = n->left.get()) {
+					path_.push_back(n);
+				};
+			};
+
+			friend class persistent_tree;
+		};
+
+		persistent_tree() = default;
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return size_;
+		};
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return size_ == 0;
+		};
+
+		[[nodiscard]] auto begin() const -> iterator {
+			auto itor = iterator();
+			itor.root_ = root_;
+			itor.descend_left(root_.get());
+			return itor;
+		};
+
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator();
+		};
+
+		// The element equivalent to key, or null.
+		template<typename Key>
+		[[nodiscard]] auto find(Key const& key) const -> T const* {
+			auto const* n = root_.get();
+			while (n != nullptr) {
+				if (Compare{}(key, n->value)) {
+					n = n->left.get();
+				}
+				else if (Compare{}(n->value, key)) {
+					n = n->right.get();
+				}
+				else {
+					return &n->value;
+				};
+			};
+			return nullptr;
+		};
+
+		// First element not ordered before key.
+		template<typename Key>
+		[[nodiscard]] auto lower_bound(Key const& key) const -> iterator {
+			auto itor = iterator();
+			itor.root_ = root_;
+			for (auto const* n = root_.get(); n != nullptr;) {
+				if (Compare{}(n->value, key)) {
+					n = n->right.get();
+				}
+				else {
+					itor.path_.push_back(n);
+					n = n->left.get();
+				};
+			};
+			return itor;
+		};
+
+		// Adds value unless an equivalent element is already there.
+		auto insert(T const& value) -> bool {
+			auto changed = false;
+			root_ = insert(root_, value, false, changed);
+			size_ += changed ? 1 : 0;
+			return changed;
+		};
+
+		// Replaces the element equivalent to value, or adds value if there is none.
+		auto insert_or_assign(T const& value) -> void {
+			auto const size = find(value) == nullptr ? size_ + 1 : size_;
+			auto changed = false;
+			root_ = insert(root_, value, true, changed);
+			size_ = size;
+		};
+
+		template<typename Key>
+		auto erase(Key const& key) -> bool {
+			auto erased = false;
+			root_ = erase(root_, key, erased);
+			size_ -= erased ? 1 : 0;
+			return erased;
+		};
+
+		auto clear() noexcept -> void {
+			root_.reset();
+			size_ = 0;
+		};
+
+		// Trees that share their root are equal without looking further.
+		auto operator==(persistent_tree const& other) const -> bool {
+			return root_ == other.root_
+			       or (size_ == other.size_ and std::equal(begin(), end(), other.begin()));
+		};
+
+	private:
+		node_ptr root_;
+		std::size_t size_ = 0;
+
+		static auto height(node_ptr const& n) -> int {
+			return n == nullptr ? 0 : n->height;
+		};
+
+		static auto make(T const& value, node_ptr left, node_ptr right) -> node_ptr {
+			auto const h = 1 + std::max(height(left), height(right));
+			return std::make_shared<node const>(node{value, std::move(left), std::move(right), h});
+		};
+
+		// A node holding value over left and right, whose heights differ by at most two, rotated
+		// back into AVL balance.
+		static auto balance(T const& value, node_ptr left, node_ptr right) -> node_ptr {
+			if (height(left) > height(right) + 1) {
+				if (height(left->left) >= height(left->right)) {
+					return make(left->value, left->left, make(value, left->right, std::move(right)));
+				};
+				auto const& pivot = left->right;
+				return make(pivot->value,
+				            make(left->value, left->left, pivot->left),
+				            make(value, pivot->right, std::move(right)));
+			};
+			if (height(right) > height(left) + 1) {
+				if (height(right->right) >= height(right->left)) {
+					return make(right->value, make(value, std::move(left), right->left), right->right);
+				};
+				auto const& pivot = right->left;
+				return make(pivot->value,
+				            make(value, std::move(left), pivot->left),
+				            make(right->value, pivot->right, right->right));
+			};
+			return make(value, std::move(left), std::move(right));
+		};
+
+		static auto insert(node_ptr const& n, T const& value, bool assign, bool& changed)
+		   -> node_ptr {
+			if (n == nullptr) {
+				changed = true;
+				return make(value, nullptr, nullptr);
+			};
+			if (Compare{}(value, n->value)) {
+				auto left = insert(n->left, value, assign, changed);
+				return changed ? balance(n->value, std::move(left), n->right) : n;
+			};
+			if (Compare{}(n->value, value)) {
+				auto right = insert(n->right, value, assign, changed);
+				return changed ? balance(n->value, n->left, std::move(right)) : n;
+			};
+			if (not assign) {
+				return n;
+			};
+			changed = true;
+			return make(value, n->left, n->right);
+		};
+
+		template<typename Key>
+		static auto erase(node_ptr const& n, Key const& key, bool& erased) -> node_ptr {
+			if (n == nullptr) {
+				return n;
+			};
+			if (Compare{}(key, n->value)) {
+				auto left = erase(n->left, key, erased);
+				return erased ? balance(n->value, std::move(left), n->right) : n;
+			};
+			if (Compare{}(n->value, key)) {
+				auto right = erase(n->right, key, erased);
+				return erased ? balance(n->value, n->left, std::move(right)) : n;
+			};
+			erased = true;
+			if (n->left == nullptr) {
+				return n->right;
+			};
+			if (n->right == nullptr) {
+				return n->left;
+			};
+			auto const* successor = n->right.get();
+			while (successor->left != nullptr) {
+				successor = successor->left.get();
+			};
+			return balance(successor->value, n->left, erase_min(n->right));
+		};
+
+		static auto erase_min(node_ptr const& n) -> node_ptr {
+			if (n->left == nullptr) {
+				return n->right;
+			};
+			return balance(n->value, erase_min(n->left), n->right);
+		};
+	};
+} // namespace gdwg::detail
+#endif // GDWG_PERSISTENT_TREE_HPP
@@ -0,0 +1,241 @@
+#ifndef GDWG_SHORTEST_PATHS_HPP
+#define GDWG_SHORTEST_PATHS_HPP
+
+#include <gdwg/csr_graph.hpp>
+#include <gdwg/graph.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Single-source shortest paths (Dijkstra) over a CSR snapshot, so the search works on dense node
+// indices and contiguous edge arrays and never looks a value up in the inner loop.
+namespace gdwg {
+	namespace detail {
+		// D-ary min-heap of (key, index) pairs over indices [0, size) supporting decrease-key. The
+		// position of every queued index is tracked, and keys sit next to their index so sifting
+		// touches one array. A fan-out of 4 keeps the heap shallow and each set of children within
+		// a cache line or two.
+		template<typename Key, std::size_t D = 4>
+		class indexed_heap {
+		public:
+			explicit indexed_heap(std::size_t size)
+			: position_(size, npos) {}
+
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return heap_.empty();
+			};
+
+			// Queues index with key, or lowers its key if it is already queued.
+			auto push_or_decrease(std::size_t index, Key const& key) -> void {
+				if (position_[index] == npos) {
+					position_[index] = heap_.size();
+					heap_.emplace_back(key, index);
+				}
+				else {
+					heap_[position_[index]].first = key;
+				};
+				sift_up(position_[index]);
+			};
+
+			auto pop() -> std::pair<Key, std::size_t> {
+				auto top = std::move(heap_.front());
+				position_[top.second] = npos;
+				if (heap_.size() > 1) {
+					place(0, std::move(heap_.back()));
+					heap_.pop_back();
+					sift_down(0);
+				}
+				else {
+					heap_.pop_back();
+				};
+				return top;
+			};
+
+		private:
+			static constexpr auto npos = std::numeric_limits<std::size_t>::max();
+
+			std::vector<std::pair<Key, std::size_t>> heap_;
+			std::vector<std::size_t> position_;
+
+			auto place(std::size_t at, std::pair<Key, std::size_t>&& entry) -> void {
+				position_[entry.second] = at;
+				heap_[at] = std::move(entry);
+			};
+
+			auto sift_up(std::size_t at) -> void {
+				auto entry = std::move(heap_[at]);
+				while (at > 0 and entry.first < heap_[(at - 1) / D].first) {
+					auto const parent = (at - 1) / D;
+					place(at, std::move(heap_[parent]));
+					at = parent;
+				};
+				place(at, std::move(entry));
+			};
+
+			auto sift_down(std::size_t at) -> void {
+				auto entry = std::move(heap_[at]);
+				while (true) {
+					auto const first_child = at * D + 1;
+					if (first_child >= heap_.size()) {
+						break;
+					};
+					auto const last_child = std::min(first_child + D, heap_.size());
+					auto smallest = first_child;
+					for (auto child = first_child + 1; child < last_child; ++child) {
+						if (heap_[child].first < heap_[smallest].first) {
+							smallest = child;
+						};
+					};
+					if (not(heap_[smallest].first < entry.first)) {
+						break;
+					};
+					place(at, std::move(heap_[smallest]));
+					at = smallest;
+				};
+				place(at, std::move(entry));
+			};
+		};
+	} // namespace detail
+
+	// Distances and predecessors of every node reachable from a source, as computed by
+	// shortest_paths. Holds its own (shared, read-only) snapshot of the graph it was computed on.
+	template<typename N, typename E>
+	class shortest_path_tree {
+	public:
+		using size_type = std::size_t;
+
+		[[nodiscard]] auto source() const -> N const& {
+			return g_.node(source_);
+		};
+
+		[[nodiscard]] auto is_reachable(N const& dst) const -> bool {
+			return reached_[index_of(dst, "is_reachable")];
+		};
+
+		// Length of the shortest path from the source to dst.
+		[[nodiscard]] auto distance(N const& dst) const -> E {
+			auto const index = index_of(dst, "distance");
+			if (not reached_[index]) {
+				throw std::runtime_error("Cannot call gdwg::shortest_path_tree<N, E>::distance "
+				                         "if dst isn't reachable from the source");
+			};
+			return distance_[index];
+		};
+
+		// The node before dst on a shortest path, if dst is reachable and isn't the source.
+		[[nodiscard]] auto predecessor(N const& dst) const -> std::optional<N> {
+			auto const index = index_of(dst, "predecessor");
+			if (not reached_[index] or index == source_) {
+				return std::nullopt;
+			};
+			return g_.node(predecessor_[index]);
+		};
+
+		// The nodes of a shortest path from the source to dst, both included; empty if dst isn't
+		// reachable.
+		[[nodiscard]] auto path(N const& dst) const -> std::vector<N> {
+			auto index = index_of(dst, "path");
+			auto path = std::vector<N>();
+			if (not reached_[index]) {
+				return path;
+			};
+			for (; index != source_; index = predecessor_[index]) {
+				path.push_back(g_.node(index));
+			};
+			path.push_back(g_.node(source_));
+			std::reverse(path.begin(), path.end());
+			return path;
+		};
+
+	private:
+		csr_graph<N, E> g_;
+		size_type source_;
+		std::vector<E> distance_;
+		std::vector<size_type> predecessor_;
+		std::vector<bool> reached_;
+
+		shortest_path_tree(csr_graph<N, E> g, size_type source)
+		: g_{std::move(g)}
+		, source_{source}
+		, distance_(g_.num_nodes())
+		, predecessor_(g_.num_nodes(), source)
+		, reached_(g_.num_nodes()) {}
+
+		auto index_of(N const& value, char const* caller) const -> size_type {
+			auto index = g_.node_index(value);
+			if (not index) {
+				throw std::runtime_error(std::string("Cannot call gdwg::shortest_path_tree<N, E>::")
+				                         + caller + " if dst doesn't exist in the graph");
+			};
+			return *index;
+		};
+
+		template<typename M, typename F>
+		friend auto shortest_paths(csr_graph<M, F> const& g, std::type_identity_t<M> const& src)
+		   -> shortest_path_tree<M, F>;
+	};
+
+	// Dijkstra from src. Weights must be non-negative; where several edges join the same pair of
+	// nodes only the lightest counts. O((n + e) log n) after the snapshot is taken.
+	template<typename N, typename E>
+	auto shortest_paths(csr_graph<N, E> const& g, std::type_identity_t<N> const& src)
+	   -> shortest_path_tree<N, E> {
+		auto const source = g.node_index(src);
+		if (not source) {
+			throw std::runtime_error("Cannot call gdwg::shortest_paths "
+			                         "if src doesn't exist in the graph");
+		};
+		auto tree = shortest_path_tree<N, E>(g, *source);
+		auto settled = std::vector<bool>(g.num_nodes());
+		auto queue = detail::indexed_heap<E>(g.num_nodes());
+		tree.distance_[*source] = E{};
+		tree.reached_[*source] = true;
+		queue.push_or_decrease(*source, E{});
+		while (not queue.empty()) {
+			auto const [distance, from] = queue.pop();
+			settled[from] = true;
+			auto const targets = g.out_targets(from);
+			auto const weights = g.out_weights(from);
+			for (auto i = std::size_t{0}; i < targets.size(); ++i) {
+				auto const to = targets[i];
+				// Parallel edges are sorted by weight, so only the first of each run matters.
+				if (i > 0 and targets[i - 1] == to) {
+					continue;
+				};
+				if (weights[i] < E{}) {
+					throw std::runtime_error("Cannot call gdwg::shortest_paths "
+					                         "on a graph with negative weights");
+				};
+				if (settled[to]) {
+					continue;
+				};
+				auto candidate = distance + weights[i];
+				if (not tree.reached_[to] or candidate < tree.distance_[to]) {
+					tree.reached_[to] = true;
+					tree.predecessor_[to] = from;
+					queue.push_or_decrease(to, candidate);
+					tree.distance_[to] = std::move(candidate);
+				};
+			};
+		};
+		return tree;
+	};
+
+	template<typename N, typename E, typename Alloc, typename Index>
+	auto shortest_paths(graph<N, E, Alloc, Index> const& g, std::type_identity_t<N> const& src)
+	   -> shortest_path_tree<N, E> {
+		if (not g.is_node(src)) {
+			throw std::runtime_error("Cannot call gdwg::shortest_paths "
+			                         "if src doesn't exist in the graph");
+		};
+		return shortest_paths(csr_graph(g), src);
+	};
+} // namespace gdwg
+#endif // GDWG_SHORTEST_PATHS_HPP
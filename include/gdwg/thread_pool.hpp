@@ -0,0 +1,118 @@
+#ifndef GDWG_THREAD_POOL_HPP
+#define GDWG_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gdwg {
+	// Fixed set of worker threads for data-parallel loops. run() hands out task numbers from a
+	// shared counter, so uneven tasks balance themselves, and the calling thread works alongside
+	// the pool until every task has finished. Threads are started once and reused across calls, so
+	// callers that run many small parallel searches can keep one pool and pass it to each (see
+	// reachable and bfs_levels). One call to run() may be in progress at a time.
+	class thread_pool {
+	public:
+		// Zero means one thread per hardware thread. The calling thread counts as one of them.
+		explicit thread_pool(std::size_t threads = 0) {
+			if (threads == 0) {
+				threads = std::max(1U, std::thread::hardware_concurrency());
+			};
+			workers_.reserve(threads - 1);
+			for (auto i = std::size_t{1}; i < threads; ++i) {
+				workers_.emplace_back([this](std::stop_token stop) { work(stop); });
+			};
+		};
+
+		thread_pool(thread_pool const&) = delete;
+		auto operator=(thread_pool const&) -> thread_pool& = delete;
+
+		~thread_pool() {
+			for (auto& worker : workers_) {
+				worker.request_stop();
+			};
+			wake_.notify_all();
+		};
+
+		[[nodiscard]] auto size() const noexcept -> std::size_t {
+			return workers_.size() + 1;
+		};
+
+		// Calls task(i) for every i in [0, tasks) and returns once all calls have returned. Tasks
+		// must not throw.
+		template<typename Task>
+		auto run(std::size_t tasks, Task&& task) -> void {
+			if (tasks == 0) {
+				return;
+			};
+			auto const body = std::function<void(std::size_t)>(std::forward<Task>(task));
+			auto current = job{.body = &body, .tasks = tasks, .unfinished = tasks};
+			{
+				auto const lock = std::scoped_lock(mutex_);
+				job_ = &current;
+				++generation_;
+			};
+			wake_.notify_all();
+			drain(current);
+			auto lock = std::unique_lock(mutex_);
+			done_.wait(lock, [&current] { return current.unfinished == 0 and current.helpers == 0; });
+			job_ = nullptr;
+		};
+
+	private:
+		// One call to run(). It lives on the caller's stack, so the caller waits for every worker
+		// that picked it up to let go of it.
+		struct job {
+			std::function<void(std::size_t)> const* body;
+			std::size_t tasks;
+			std::atomic<std::size_t> next = 0;
+			// Guarded by mutex_.
+			std::size_t unfinished;
+			std::size_t helpers = 0;
+		};
+
+		std::mutex mutex_;
+		std::condition_variable_any wake_;
+		std::condition_variable done_;
+		job* job_ = nullptr;
+		std::size_t generation_ = 0;
+		// Declared last so the workers are joined before anything they use is destroyed.
+		std::vector<std::jthread> workers_;
+
+		// Runs tasks of current until there are none left to claim.
+		auto drain(job& current) -> void {
+			auto finished = std::size_t{0};
+			for (auto i = current.next.fetch_add(1); i < current.tasks;) {
+				(*current.body)(i);
+				++finished;
+				i = current.next.fetch_add(1);
+			};
+			auto const lock = std::scoped_lock(mutex_);
+			current.unfinished -= finished;
+		};
+
+		auto work(std::stop_token stop) -> void {
+			auto seen = std::size_t{0};
+			auto lock = std::unique_lock(mutex_);
+			while (wake_.wait(lock, stop, [&] { return generation_ != seen; })) {
+				seen = generation_;
+				auto* current = job_;
+				if (current == nullptr) {
+					continue;
+				};
+				++current->helpers;
+				lock.unlock();
+				drain(*current);
+				lock.lock();
+				--current->helpers;
+				done_.notify_all();
+			};
+		};
+	};
+} // namespace gdwg
+#endif // GDWG_THREAD_POOL_HPP
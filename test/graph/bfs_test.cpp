@@ -0,0 +1,92 @@
+#include "gdwg/bfs.hpp"
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST_CASE("Reachability") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e", "f"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "b", 2);
+	g.insert_edge("b", "c", 1);
+	g.insert_edge("a", "d", 1);
+	g.insert_edge("d", "c", 1);
+	g.insert_edge("c", "a", 1);
+	g.insert_edge("e", "a", 1);
+	g.insert_edge("f", "f", 1);
+
+	SECTION("Reachable") {
+		CHECK(gdwg::reachable(g, "a") == std::vector<std::string>{"a", "b", "c", "d"});
+		CHECK(gdwg::reachable(g, "e") == std::vector<std::string>{"a", "b", "c", "d", "e"});
+		CHECK(gdwg::reachable(g, "f") == std::vector<std::string>{"f"});
+	}
+
+	SECTION("Levels") {
+		using levels = std::vector<std::vector<std::string>>;
+		CHECK(gdwg::bfs_levels(g, "a") == levels{{"a"}, {"b", "d"}, {"c"}});
+		CHECK(gdwg::bfs_levels(g, "e") == levels{{"e"}, {"a"}, {"b", "d"}, {"c"}});
+		CHECK(gdwg::bfs_levels(g, "b") == levels{{"b"}, {"c"}, {"a"}, {"d"}});
+	}
+
+	SECTION("Missing source") {
+		CHECK_THROWS_MATCHES(gdwg::reachable(g, "z"),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::reachable "
+		                                              "if src doesn't exist in the graph"));
+		auto const csr = gdwg::csr_graph(g);
+		CHECK_THROWS_MATCHES(gdwg::bfs_levels(csr, "z"),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::bfs_levels "
+		                                              "if src doesn't exist in the graph"));
+	}
+}
+
+TEST_CASE("Levels match a serial search") {
+	// Dense enough for the search to go bottom-up for a few levels, and sized so that the last
+	// bitmap word is partly used.
+	auto const num_nodes = 3000;
+	auto rng = std::mt19937{6771};
+	auto node = std::uniform_int_distribution<int>{0, num_nodes - 1};
+	auto const degree = GENERATE(1, 3, 12);
+	auto g = gdwg::graph<int, int>{};
+	for (auto i = 0; i < num_nodes; ++i) {
+		g.insert_node(i);
+	}
+	for (auto i = 0; i < num_nodes * degree; ++i) {
+		g.insert_edge(node(rng), node(rng), 0);
+	}
+
+	auto depth = std::map<int, std::size_t>{{0, 0}};
+	auto queue = std::deque<int>{0};
+	while (not queue.empty()) {
+		auto const from = queue.front();
+		queue.pop_front();
+		for (auto const to : g.connections(from)) {
+			if (depth.try_emplace(to, depth[from] + 1).second) {
+				queue.push_back(to);
+			}
+		}
+	}
+	auto expected = std::vector<std::vector<int>>();
+	for (auto const& [n, d] : depth) {
+		if (d >= expected.size()) {
+			expected.resize(d + 1);
+		}
+		expected[d].push_back(n);
+	}
+
+	auto const csr = gdwg::csr_graph(g);
+	for (auto const threads : {std::size_t{1}, std::size_t{3}, std::size_t{8}}) {
+		CHECK(gdwg::bfs_levels(csr, 0, threads) == expected);
+		CHECK(gdwg::reachable(csr, 0, threads).size() == depth.size());
+	}
+	// One pool serves any number of searches.
+	auto pool = gdwg::thread_pool(4);
+	for (auto i = 0; i < 3; ++i) {
+		CHECK(gdwg::bfs_levels(csr, 0, pool) == expected);
+		CHECK(gdwg::reachable(g, 0, pool).size() == depth.size());
+	}
+}
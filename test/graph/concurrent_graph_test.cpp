@@ -0,0 +1,135 @@
+#include "gdwg/concurrent_graph.hpp"
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Concurrent graph") {
+	auto g = gdwg::graph<std::string, int>{"how", "are", "you"};
+	g.insert_edge("how", "are", 1);
+	g.insert_edge("how", "you", 2);
+	auto cg = gdwg::concurrent_graph<std::string, int>(g);
+
+	SECTION("Reads") {
+		CHECK(cg.is_node("how"));
+		CHECK_FALSE(cg.is_node("?"));
+		CHECK(cg.is_connected("how", "are"));
+		CHECK(cg.weights("how", "you") == std::vector<int>{2});
+		CHECK(cg.connections("how") == std::vector<std::string>{"are", "you"});
+		REQUIRE(cg.find("how", "you", 2).has_value());
+		CHECK(cg.find("how", "you", 2)->weight == 2);
+		CHECK(cg.find("how", "you", 3) == std::nullopt);
+		CHECK(cg.snapshot() == g);
+	}
+
+	SECTION("Writes reach both copies") {
+		CHECK(cg.insert_node("?"));
+		CHECK(cg.insert_edge("you", "?", 3));
+		CHECK_FALSE(cg.insert_edge("you", "?", 3));
+		CHECK(cg.erase_edge("how", "are", 1));
+		CHECK(cg.replace_node("how", "why"));
+		cg.merge_replace_node("are", "you");
+		CHECK(cg.erase_node("?"));
+		g.insert_node("?");
+		g.insert_edge("you", "?", 3);
+		g.erase_edge("how", "are", 1);
+		g.replace_node("how", "why");
+		g.merge_replace_node("are", "you");
+		g.erase_node("?");
+		// Alternate between reads, which see one copy, and writes, which flip to the other.
+		for (auto i = 0; i < 3; ++i) {
+			CHECK(cg.snapshot() == g);
+			cg.insert_node("x");
+			cg.erase_node("x");
+		}
+		cg.clear();
+		CHECK(cg.snapshot().empty());
+	}
+
+	SECTION("A throwing write changes nothing") {
+		CHECK_THROWS_AS(cg.insert_edge("how", "?", 1), std::runtime_error);
+		CHECK(cg.snapshot() == g);
+		CHECK(cg.insert_node("?"));
+		CHECK(cg.snapshot().is_node("?"));
+	}
+
+	SECTION("A write that throws partway through changes neither copy") {
+		auto const insert_then_throw = [](auto& copy) {
+			copy.insert_edge("are", "you", 5);
+			throw std::runtime_error("partway");
+		};
+		CHECK_THROWS_AS(cg.write(insert_then_throw), std::runtime_error);
+		// Each write flips readers to the other copy.
+		for (auto const* value : {"x", "y"}) {
+			CHECK(cg.insert_node(value));
+			CHECK_FALSE(cg.is_connected("are", "you"));
+		}
+		g.insert_node("x");
+		g.insert_node("y");
+		CHECK(cg.snapshot() == g);
+	}
+}
+
+TEST_CASE("Concurrent readers see every write whole") {
+	// The writer only ever adds or removes an edge together with its reverse, in one write, so a
+	// reader that sees one without the other has seen a write half done.
+	auto cg = gdwg::concurrent_graph<int, int>{};
+	for (auto i = 0; i < 32; ++i) {
+		cg.insert_node(i);
+	}
+	auto done = std::atomic<bool>{false};
+	auto torn = std::atomic<int>{0};
+	auto reads = std::atomic<int>{0};
+	auto readers = std::vector<std::jthread>();
+	for (auto t = 0; t < 4; ++t) {
+		readers.emplace_back([&, t] {
+			auto rng = std::mt19937(static_cast<unsigned>(t));
+			auto node = std::uniform_int_distribution<int>{0, 31};
+			while (not done.load()) {
+				auto const a = node(rng);
+				auto const b = node(rng);
+				auto const symmetric = cg.read([&](gdwg::graph<int, int> const& g) {
+					return g.weights(a, b) == g.weights(b, a);
+				});
+				torn += symmetric ? 0 : 1;
+				torn += cg.is_node(a) ? 0 : 1;
+				++reads;
+				// Be preempted between reads rather than during them, which on a machine with fewer
+				// cores than threads would hold up each write for a time slice.
+				std::this_thread::yield();
+			}
+		});
+	}
+
+	auto rng = std::mt19937{2024};
+	auto node = std::uniform_int_distribution<int>{0, 31};
+	for (auto i = 0; i < 5000; ++i) {
+		auto const a = node(rng);
+		auto const b = node(rng);
+		auto const weight = i % 5;
+		cg.write([&](gdwg::graph<int, int>& g) {
+			if (not g.erase_edge(a, b, weight)) {
+				g.insert_edge(a, b, weight);
+				g.insert_edge(b, a, weight);
+			}
+			else {
+				g.erase_edge(b, a, weight);
+			}
+		});
+		std::this_thread::yield();
+	}
+	// Make sure the readers overlapped with at least some of the writes.
+	while (reads.load() < 1000) {
+		std::this_thread::yield();
+	}
+	done = true;
+	readers.clear();
+	CHECK(torn.load() == 0);
+	auto const g = cg.snapshot();
+	for (auto const& [from, to, weight] : g) {
+		CHECK(g.find(to, from, weight) != g.end());
+	}
+}
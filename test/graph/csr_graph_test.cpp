@@ -0,0 +1,318 @@
+#include "gdwg/csr_graph.hpp"
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+TEST_CASE("CSR snapshot") {
+	auto g = gdwg::graph<std::string, int>{"how", "are", "you", "?"};
+	g.insert_edge("how", "are", 1);
+	g.insert_edge("how", "you", 2);
+	g.insert_edge("how", "you", 5);
+	g.insert_edge("are", "you", 3);
+	g.insert_edge("you", "you", 4);
+	auto const csr = gdwg::csr_graph(g);
+
+	SECTION("Empty") {
+		auto const empty = gdwg::csr_graph(gdwg::graph<std::string, int>{});
+		CHECK(empty.empty());
+		CHECK(empty.begin() == empty.end());
+		CHECK(empty == gdwg::csr_graph<std::string, int>{});
+		CHECK_FALSE(csr.empty());
+	}
+
+	SECTION("Is node") {
+		CHECK(csr.is_node("how"));
+		CHECK(csr.is_node("?"));
+		CHECK_FALSE(csr.is_node("hello"));
+	}
+
+	SECTION("Nodes in vector") {
+		CHECK(csr.nodes() == g.nodes());
+	}
+
+	SECTION("Is connected") {
+		CHECK(csr.is_connected("how", "you"));
+		CHECK(csr.is_connected("you", "you"));
+		CHECK_FALSE(csr.is_connected("you", "how"));
+		CHECK_FALSE(csr.is_connected("?", "how"));
+		CHECK_THROWS_MATCHES(csr.is_connected("hello", "how"),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::csr_graph<N, E>::is_connected "
+		                                              "if src or dst node don't exist in the graph"));
+	}
+
+	SECTION("Weights in vector") {
+		CHECK(csr.weights("how", "you") == std::vector<int>{2, 5});
+		CHECK(csr.weights("are", "you") == std::vector<int>{3});
+		CHECK(csr.weights("you", "how").empty());
+		CHECK_THROWS_MATCHES(csr.weights("how", "hello"),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::csr_graph<N, E>::weights "
+		                                              "if src or dst node don't exist in the graph"));
+	}
+
+	SECTION("Connections") {
+		CHECK(csr.connections("how") == std::vector<std::string>{"are", "you"});
+		CHECK(csr.connections("you") == std::vector<std::string>{"you"});
+		CHECK(csr.connections("?").empty());
+		CHECK_THROWS_MATCHES(csr.connections("hello"),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::csr_graph<N, E>::connections "
+		                                              "if src doesn't exist in the graph"));
+	}
+
+	SECTION("Find edge") {
+		auto it = csr.find("how", "you", 5);
+		REQUIRE(it != csr.end());
+		CHECK((*it).from == "how");
+		CHECK((*it).to == "you");
+		CHECK((*it).weight == 5);
+		CHECK(csr.find("how", "you", 3) == csr.end());
+		CHECK(csr.find("hello", "you", 3) == csr.end());
+		CHECK(++it == csr.find("you", "you", 4));
+	}
+
+	SECTION("Iteration matches the graph") {
+		auto expected = std::vector<std::tuple<std::string, std::string, int>>{};
+		for (auto const& [from, to, weight] : g) {
+			expected.emplace_back(from, to, weight);
+		}
+		auto forward = std::vector<std::tuple<std::string, std::string, int>>{};
+		for (auto const& [from, to, weight] : csr) {
+			forward.emplace_back(from, to, weight);
+		}
+		CHECK(forward == expected);
+
+		auto backward = std::vector<std::tuple<std::string, std::string, int>>{};
+		for (auto it = csr.end(); it != csr.begin();) {
+			--it;
+			backward.emplace_back((*it).from, (*it).to, (*it).weight);
+		}
+		std::reverse(backward.begin(), backward.end());
+		CHECK(backward == expected);
+	}
+
+	SECTION("End steps back over trailing nodes without edges") {
+		auto trailing = g;
+		trailing.insert_node("~");
+		trailing.insert_node("~~");
+		auto const snapshot = gdwg::csr_graph(trailing);
+		CHECK(snapshot.find("~", "you", 1) == snapshot.end());
+		auto last = snapshot.end();
+		--last;
+		CHECK(last == snapshot.find("you", "you", 4));
+		CHECK((*last).from == "you");
+		CHECK(snapshot.end() - 1 == last);
+	}
+
+	SECTION("Random access") {
+		static_assert(std::random_access_iterator<gdwg::csr_graph<std::string, int>::iterator>);
+		CHECK(csr.num_nodes() == g.num_nodes());
+		CHECK(csr.num_edges() == g.num_edges());
+		CHECK(csr.end() - csr.begin() == static_cast<std::ptrdiff_t>(csr.num_edges()));
+		// Every jump lands where stepping one edge at a time would.
+		auto stepped = std::vector<gdwg::csr_graph<std::string, int>::iterator>{};
+		for (auto it = csr.begin(); it != csr.end(); ++it) {
+			stepped.push_back(it);
+		}
+		stepped.push_back(csr.end());
+		auto const size = static_cast<std::ptrdiff_t>(csr.num_edges());
+		for (auto i = std::ptrdiff_t{0}; i <= size; ++i) {
+			for (auto j = std::ptrdiff_t{0}; j <= size; ++j) {
+				auto const jumped = stepped[i] + (j - i);
+				CHECK(jumped == stepped[j]);
+				CHECK(jumped - stepped[i] == j - i);
+				CHECK((jumped < stepped[i]) == (j < i));
+				if (j < size) {
+					CHECK(&(*jumped).from == &(*stepped[j]).from);
+					CHECK(&stepped[i][j - i].to == &(*stepped[j]).to);
+				}
+			}
+		}
+		CHECK(--(csr.end() - 1) == csr.find("how", "you", 5));
+		CHECK((*(csr.end() - 1)).from == "you");
+		CHECK((*(csr.begin() + 1)).from == "how");
+	}
+
+	SECTION("In-edges by index") {
+		auto const index = [&csr](std::string const& value) { return *csr.node_index(value); };
+		auto const sources = [&csr](std::size_t i) {
+			auto const in = csr.in_sources(i);
+			return std::vector<std::size_t>(in.begin(), in.end());
+		};
+		auto const how = index("how");
+		CHECK(sources(index("you")) == std::vector{index("are"), how, how, index("you")});
+		CHECK(sources(index("are")) == std::vector{index("how")});
+		CHECK(sources(index("how")).empty());
+		auto const copy = csr;
+		CHECK(copy.in_sources(index("you")).data() == csr.in_sources(index("you")).data());
+	}
+
+	SECTION("Moving leaves the source empty") {
+		static_assert(std::is_nothrow_move_constructible_v<gdwg::csr_graph<int, int>>);
+		static_assert(std::is_nothrow_move_assignable_v<gdwg::csr_graph<int, int>>);
+		auto source = csr;
+		auto const you = *csr.node_index("you");
+		CHECK(source.in_sources(you).size() == 4);
+		{
+			auto const moved = std::move(source);
+			CHECK(moved == csr);
+			CHECK(moved.in_sources(you).size() == 4);
+		}
+		// The storage went with the moved-to snapshot, which is gone again.
+		CHECK(source.empty());
+		CHECK(source.begin() == source.end());
+		CHECK(source == gdwg::csr_graph<std::string, int>{});
+		source = csr;
+		CHECK(source.in_sources(you).size() == 4);
+
+		auto target = gdwg::csr_graph(gdwg::graph<std::string, int>{"?"});
+		target = std::move(source);
+		CHECK(target == csr);
+		CHECK(source.empty());
+		CHECK(source.nodes().empty());
+	}
+
+	SECTION("Snapshot is independent of the graph") {
+		g.erase_node("how");
+		CHECK(csr.is_node("how"));
+		CHECK(csr.weights("how", "you") == std::vector<int>{2, 5});
+		CHECK_FALSE(csr == gdwg::csr_graph(g));
+	}
+}
+
+namespace {
+	// A file in the temporary directory that is removed again at the end of the test.
+	struct temporary_file {
+		std::filesystem::path path = std::filesystem::temp_directory_path() / "gdwg_csr_graph_test.bin";
+		temporary_file() = default;
+		temporary_file(temporary_file const&) = delete;
+		auto operator=(temporary_file const&) -> temporary_file& = delete;
+		~temporary_file() {
+			std::filesystem::remove(path);
+		}
+	};
+
+	template<typename N, typename E>
+	auto write(std::filesystem::path const& path, gdwg::graph<N, E> const& g) -> void {
+		auto out = std::ofstream(path, std::ios::binary);
+		gdwg::csr_graph(g).write_binary(out);
+	}
+
+	// Overwrites the first run of bytes in the file that holds before with the bytes of after.
+	template<typename T>
+	auto patch(std::filesystem::path const& path,
+	           std::vector<T> const& before,
+	           std::vector<T> const& after) -> void {
+		auto file = std::fstream(path, std::ios::binary | std::ios::in | std::ios::out);
+		auto const bytes = std::string(std::istreambuf_iterator<char>(file), {});
+		auto const needle = std::string(reinterpret_cast<char const*>(before.data()),
+		                                before.size() * sizeof(T));
+		auto const position = bytes.find(needle);
+		REQUIRE(position != std::string::npos);
+		file.seekp(static_cast<std::streamoff>(position));
+		file.write(reinterpret_cast<char const*>(after.data()),
+		           static_cast<std::streamsize>(after.size() * sizeof(T)));
+	}
+
+	template<typename N, typename E>
+	auto to_graph(gdwg::csr_graph<N, E> const& csr) -> gdwg::graph<N, E> {
+		auto const nodes = csr.nodes();
+		return gdwg::graph<N, E>(nodes.begin(), nodes.end(), csr.begin(), csr.end());
+	}
+} // namespace
+
+TEST_CASE("Binary format") {
+	using csr = gdwg::csr_graph<int, double>;
+	auto const file = temporary_file{};
+	auto g = gdwg::graph<int, double>{1, 2, 3, 4, 5, 64};
+	g.insert_edge(4, 1, -4.5);
+	g.insert_edge(3, 2, 2);
+	g.insert_edge(2, 4, 2);
+	g.insert_edge(2, 1, 1);
+	g.insert_edge(2, 1, 0.25);
+	g.insert_edge(5, 5, 7);
+
+	SECTION("Round trip") {
+		write(file.path, g);
+		auto const mapped = csr::map_binary(file.path);
+		CHECK(mapped == gdwg::csr_graph(g));
+		CHECK(to_graph(mapped) == g);
+		CHECK(mapped.weights(2, 1) == std::vector<double>{0.25, 1});
+		CHECK(mapped.connections(2) == std::vector<int>{1, 4});
+		CHECK(mapped.is_node(64));
+		CHECK(mapped.find(5, 5, 7) != mapped.end());
+	}
+
+	SECTION("Empty round trip") {
+		write(file.path, gdwg::graph<int, double>{});
+		auto const mapped = csr::map_binary(file.path);
+		CHECK(mapped.empty());
+		CHECK(to_graph(mapped) == gdwg::graph<int, double>{});
+	}
+
+	SECTION("Nodes without edges round trip") {
+		auto const nodes = gdwg::graph<char, int>{'a', 'b', 'c'};
+		write(file.path, nodes);
+		CHECK(to_graph(gdwg::csr_graph<char, int>::map_binary(file.path)) == nodes);
+	}
+
+	SECTION("Mapping outlives the file and is shared by copies") {
+		write(file.path, g);
+		auto copy = csr{};
+		{
+			auto const mapped = csr::map_binary(file.path);
+			copy = mapped;
+		}
+		std::filesystem::remove(file.path);
+		CHECK(to_graph(copy) == g);
+	}
+
+	SECTION("Rejects incompatible files") {
+		auto const message = Catch::Matchers::Message("Cannot call gdwg::csr_graph<N, E>::map_binary "
+		                                              "if the file isn't a binary csr_graph");
+		write(file.path, g);
+		// Weights were written as doubles.
+		using int_weights = gdwg::csr_graph<int, int>;
+		CHECK_THROWS_MATCHES(int_weights::map_binary(file.path), std::runtime_error, message);
+
+		std::filesystem::resize_file(file.path, std::filesystem::file_size(file.path) - 1);
+		CHECK_THROWS_MATCHES(csr::map_binary(file.path),
+		                     std::runtime_error,
+		                     message);
+
+		std::ofstream(file.path) << "not a graph";
+		CHECK_THROWS_MATCHES(csr::map_binary(file.path),
+		                     std::runtime_error,
+		                     message);
+
+		// Node indices, in edge order: 2->1 twice, 2->4, 3->2, 4->1, 5->5.
+		auto const targets = std::vector<std::size_t>{0, 0, 3, 1, 0, 4};
+		write(file.path, g);
+		patch(file.path, targets, std::vector<std::size_t>{0, 0, 6, 1, 0, 4});
+		CHECK_THROWS_MATCHES(csr::map_binary(file.path), std::runtime_error, message);
+
+		write(file.path, g);
+		patch(file.path, std::vector<std::size_t>{0, 0, 3, 4, 5, 6, 6}, {0, 0, 3, 2, 5, 6, 6});
+		CHECK_THROWS_MATCHES(csr::map_binary(file.path), std::runtime_error, message);
+
+		write(file.path, g);
+		patch(file.path, std::vector<int>{1, 2, 3, 4, 5, 64}, {1, 2, 3, 3, 5, 64});
+		CHECK_THROWS_MATCHES(csr::map_binary(file.path), std::runtime_error, message);
+
+		std::filesystem::remove(file.path);
+		CHECK_THROWS_MATCHES(csr::map_binary(file.path),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::csr_graph<N, E>::map_binary "
+		                                              "if the file can't be opened"));
+	}
+}
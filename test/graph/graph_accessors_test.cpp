@@ -1,6 +1,10 @@
 #include "gdwg/graph.hpp"
 #include <catch2/catch.hpp>
+#include <concepts>
+#include <ranges>
 #include <string>
+#include <string_view>
+#include <vector>
 
 TEST_CASE("Accessors") {
 	auto g = gdwg::graph<std::string, int>{"how", "are", "you"};
@@ -25,6 +29,19 @@ TEST_CASE("Accessors") {
 		CHECK_FALSE(g.empty());
 		CHECK_FALSE(const_g.empty());
 	}
+	SECTION("Counts") {
+		CHECK(gdwg::graph<std::string, int>{}.num_nodes() == 0);
+		CHECK(gdwg::graph<std::string, int>{}.num_edges() == 0);
+		CHECK(const_g.num_nodes() == 3);
+		CHECK(const_g.num_edges() == static_cast<std::size_t>(std::distance(g.begin(), g.end())));
+		g.insert_node("?");
+		g.insert_edge("?", "?", 0);
+		CHECK(g.num_nodes() == 4);
+		CHECK(g.num_edges() == const_g.num_edges() + 1);
+		g.erase_node("how");
+		CHECK(g.num_nodes() == 3);
+		CHECK(g.num_edges() == static_cast<std::size_t>(std::distance(g.begin(), g.end())));
+	}
 	SECTION("Is connected") {
 		SECTION("Connect or not") {}
 		SECTION("Exception: either src or dst node does not exist") {}
@@ -108,3 +125,101 @@ TEST_CASE("Accessors") {
 		}
 	}
 }
+
+TEST_CASE("Lookups by key types other than N") {
+	using namespace std::string_view_literals;
+	auto g = gdwg::graph<std::string, int>{"how", "are", "you"};
+	g.insert_edge("how"sv, "are"sv, 1);
+	g.insert_edge("how", "you"sv, 2);
+
+	SECTION("String views") {
+		CHECK(g.is_node("how"sv));
+		CHECK_FALSE(g.is_node("ho"sv));
+		CHECK(g.is_connected("how"sv, "you"sv));
+		CHECK(g.weights("how"sv, "are"sv) == std::vector<int>{1});
+		CHECK(g.connections("how"sv) == std::vector<std::string>{"are", "you"});
+		CHECK(g.find("how"sv, "you"sv, 2) == g.find("how", "you", 2));
+		CHECK(g.find("how"sv, "you"sv, 3) == g.end());
+		CHECK(g.find("how"sv, "yo"sv, 2) == g.end());
+		CHECK(g.find_node("you"sv) == g.find_node("you"));
+		CHECK(g.erase_edge("how"sv, "are"sv, 1));
+		CHECK_FALSE(g.is_connected("how", "are"));
+		CHECK(g.erase_node("are"sv));
+		CHECK_FALSE(g.is_node("are"));
+	}
+
+	SECTION("Missing nodes still throw") {
+		CHECK_THROWS_MATCHES(g.weights("how"sv, "?"sv),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::weights "
+		                                              "if src or dst node don't exist in the graph"));
+	}
+
+	SECTION("Hashed index") {
+		auto h = gdwg::graph<std::string, int, std::allocator<std::byte>, gdwg::hashed_index>{"how",
+		                                                                                      "you"};
+		h.insert_edge("how"sv, "you"sv, 2);
+		CHECK(h.is_node("how"sv));
+		CHECK_FALSE(h.is_node("are"sv));
+		CHECK(h.weights("how"sv, "you"sv) == std::vector<int>{2});
+	}
+
+	SECTION("Other keys are converted to N") {
+		auto numbers = gdwg::graph<int, int>{1, 2};
+		CHECK(numbers.is_node(1.5));
+		CHECK(numbers.is_node(short{2}));
+		CHECK(numbers.insert_edge(1L, 2.0, 3));
+		CHECK(numbers.find(1, 2L, 3) != numbers.end());
+	}
+}
+
+TEST_CASE("Views") {
+	auto g = gdwg::graph<std::string, int>{"how", "are", "you"};
+	g.insert_edge("how", "are", 1);
+	g.insert_edge("how", "you", 3);
+	g.insert_edge("how", "you", 2);
+	g.insert_edge("how", "how", 4);
+	g.insert_edge("are", "you", 5);
+	auto const& const_g = g;
+
+	SECTION("Match the copying accessors") {
+		auto const nodes = const_g.nodes_view();
+		CHECK(std::vector<std::string>(nodes.begin(), nodes.end()) == g.nodes());
+		auto weights = const_g.weights_view("how", "you");
+		CHECK(std::vector<int>(weights.begin(), weights.end()) == g.weights("how", "you"));
+		auto connections = const_g.connections_view("how");
+		CHECK(std::vector<std::string>(connections.begin(), connections.end())
+		      == g.connections("how"));
+		CHECK(std::ranges::empty(g.connections_view("you")));
+		CHECK(std::ranges::empty(g.weights_view("you", "how")));
+	}
+
+	SECTION("Refer into the graph") {
+		static_assert(std::ranges::view<decltype(g.nodes_view())>);
+		static_assert(std::same_as<std::ranges::range_reference_t<decltype(g.nodes_view())>,
+		                           std::string const&>);
+		static_assert(std::same_as<std::ranges::range_reference_t<decltype(g.weights_view("", ""))>,
+		                           int const&>);
+		auto connections = g.connections_view("how");
+		auto const& are = *connections.begin();
+		CHECK(&are == &*g.nodes_view().begin());
+	}
+
+	SECTION("See later changes to the edges they span") {
+		auto const weights = g.weights_view("how", "you");
+		g.insert_edge("how", "you", 7);
+		CHECK(std::ranges::distance(weights) == 3);
+	}
+
+	SECTION("Exception: missing nodes") {
+		CHECK_THROWS_MATCHES(g.weights_view("how", "?"),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::weights_view "
+		                                              "if src or dst node don't exist in the graph"));
+		CHECK_THROWS_MATCHES(g.connections_view("?"),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::"
+		                                              "connections_view if src doesn't exist in "
+		                                              "the graph"));
+	}
+}
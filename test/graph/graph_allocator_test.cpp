@@ -0,0 +1,219 @@
+#include "gdwg/graph.hpp"
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	// Forwards to another resource, keeping track of what is currently allocated through it.
+	class counting_resource : public std::pmr::memory_resource {
+	public:
+		explicit counting_resource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+		: upstream_{upstream} {}
+
+		std::size_t allocations = 0;
+		std::size_t bytes_in_use = 0;
+
+	private:
+		std::pmr::memory_resource* upstream_;
+
+		auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+			++allocations;
+			bytes_in_use += bytes;
+			return upstream_->allocate(bytes, alignment);
+		}
+
+		auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override {
+			bytes_in_use -= bytes;
+			upstream_->deallocate(p, bytes, alignment);
+		}
+
+		[[nodiscard]] auto do_is_equal(std::pmr::memory_resource const& other) const noexcept
+		   -> bool override {
+			return this == &other;
+		}
+	};
+
+	// Makes any allocation that falls back to the default resource throw.
+	struct no_default_resource {
+		no_default_resource()
+		: previous{std::pmr::set_default_resource(std::pmr::null_memory_resource())} {}
+		no_default_resource(no_default_resource const&) = delete;
+		auto operator=(no_default_resource const&) -> no_default_resource& = delete;
+		~no_default_resource() {
+			std::pmr::set_default_resource(previous);
+		}
+		std::pmr::memory_resource* previous;
+	};
+
+	auto fill(gdwg::pmr::graph<int, int>& g) -> void {
+		for (auto i = 0; i < 10; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < 10; ++i) {
+			g.insert_edge(i, (i * 3) % 10, i);
+			g.insert_edge(i, i, -i - 1);
+		}
+	}
+} // namespace
+
+TEST_CASE("Graph allocates through its allocator") {
+	auto resource = counting_resource{};
+	{
+		auto g = gdwg::pmr::graph<int, int>(&resource);
+		CHECK(g.get_allocator().resource() == &resource);
+		fill(g);
+		CHECK(resource.allocations == 30);
+		g.replace_node(3, 30);
+		g.merge_replace_node(4, 30);
+		g.erase_node(5);
+		CHECK(g.is_connected(30, 30));
+	}
+	CHECK(resource.bytes_in_use == 0);
+}
+
+TEST_CASE("Node values and weights use the graph's allocator") {
+	auto buffer = std::vector<std::byte>(1 << 16);
+	auto arena = std::pmr::monotonic_buffer_resource(buffer.data(),
+	                                                 buffer.size(),
+	                                                 std::pmr::null_memory_resource());
+	auto const guard = no_default_resource{};
+	auto g = gdwg::pmr::graph<std::pmr::string, std::pmr::string>(&arena);
+	// All longer than the small string buffer, so each copy allocates.
+	auto const src = std::pmr::string("source node with a long name", &arena);
+	auto const dest = std::pmr::string("destination node with a long name", &arena);
+	auto const replacement = std::pmr::string("replacement node with a long name", &arena);
+	auto const weight = std::pmr::string("edge weight with a long value", &arena);
+	CHECK(g.insert_node(src));
+	CHECK(g.insert_node(dest));
+	CHECK(g.insert_edge(src, dest, weight));
+	CHECK(g.is_connected(src, dest));
+	CHECK(g.replace_node(src, replacement));
+	CHECK(g.erase_node(dest));
+}
+
+TEST_CASE("Allocator propagation") {
+	auto first = counting_resource{};
+	auto second = counting_resource{};
+	auto g = gdwg::pmr::graph<int, int>(&first);
+	fill(g);
+
+	SECTION("Copy construction selects the default resource") {
+		auto const copy = g;
+		CHECK(copy.get_allocator().resource() == std::pmr::get_default_resource());
+		CHECK(copy == g);
+	}
+
+	SECTION("Allocator-extended copy construction") {
+		auto const copy = gdwg::pmr::graph<int, int>(g, &second);
+		CHECK(copy.get_allocator().resource() == &second);
+		CHECK(second.bytes_in_use == first.bytes_in_use);
+		CHECK(copy == g);
+	}
+
+	SECTION("Move construction keeps the allocator") {
+		auto const moved = std::move(g);
+		CHECK(moved.get_allocator().resource() == &first);
+		CHECK(first.allocations == 30);
+		CHECK(g.empty());
+	}
+
+	SECTION("Allocator-extended move construction with a different resource") {
+		auto const expected = g;
+		auto moved = gdwg::pmr::graph<int, int>(std::move(g), &second);
+		CHECK(moved.get_allocator().resource() == &second);
+		CHECK(moved == expected);
+		CHECK(g.empty());
+		CHECK(moved.erase_node(3));
+	}
+
+	SECTION("Copy assignment keeps the target's allocator") {
+		auto copy = gdwg::pmr::graph<int, int>(&second);
+		copy = g;
+		CHECK(copy.get_allocator().resource() == &second);
+		CHECK(copy == g);
+	}
+
+	SECTION("Move assignment between equal allocators steals the nodes") {
+		auto moved = gdwg::pmr::graph<int, int>(&first);
+		moved = std::move(g);
+		CHECK(first.allocations == 30);
+		CHECK(g.empty());
+		CHECK(moved.erase_node(3));
+	}
+
+	SECTION("Move assignment between unequal allocators copies the elements") {
+		auto const expected = g;
+		auto const footprint = first.bytes_in_use;
+		auto moved = gdwg::pmr::graph<int, int>(&second);
+		moved = std::move(g);
+		CHECK(moved.get_allocator().resource() == &second);
+		CHECK(second.bytes_in_use == footprint);
+		CHECK(moved == expected);
+		CHECK(g.empty());
+		CHECK(first.bytes_in_use == 0);
+		CHECK(moved.erase_node(3));
+	}
+}
+
+TEST_CASE("Lookups by value do not allocate") {
+	auto resource = counting_resource{};
+	auto const guard = no_default_resource{};
+	auto g = gdwg::pmr::graph<std::pmr::string, int>(&resource);
+	// Longer than the small string buffer, so any copy would allocate.
+	auto const src = std::pmr::string("source node with a long name", &resource);
+	auto const dest = std::pmr::string("destination node with a long name", &resource);
+	auto const view = std::string_view("destination node with a long name");
+	g.insert_node(src);
+	g.insert_node(dest);
+	g.insert_edge(src, dest, 1);
+	g.insert_edge(src, dest, 2);
+	auto const allocations = resource.allocations;
+	CHECK(g.is_node(view));
+	CHECK(g.is_connected(src, view));
+	CHECK(g.find(src, dest, 1) != g.end());
+	CHECK(g.find(src, view, 3) == g.end());
+	CHECK(g.find_node(view).has_value());
+	CHECK(g.erase_edge(src, dest, 1));
+	CHECK_FALSE(g.erase_edge(src, view, 1));
+	CHECK(resource.allocations == allocations);
+}
+
+TEST_CASE("Views do not allocate") {
+	auto resource = counting_resource{};
+	auto g = gdwg::pmr::graph<int, int>(&resource);
+	fill(g);
+	auto const allocations = resource.allocations;
+	auto sum = 0;
+	for (auto const& value : g.nodes_view()) {
+		for (auto const& dest : g.connections_view(value)) {
+			for (auto const& weight : g.weights_view(value, dest)) {
+				sum += weight;
+			}
+		}
+	}
+	// fill's weights: 0 to 9, and -1 to -10 on the self-loops
+	CHECK(sum == 45 - 55);
+	CHECK(resource.allocations == allocations);
+}
+
+TEST_CASE("Iteration does not allocate") {
+	auto resource = counting_resource{};
+	auto const guard = no_default_resource{};
+	auto g = gdwg::pmr::graph<std::pmr::string, int>(&resource);
+	auto const src = std::pmr::string("source node with a long name", &resource);
+	auto const dest = std::pmr::string("destination node with a long name", &resource);
+	g.insert_node(src);
+	g.insert_node(dest);
+	g.insert_edge(src, dest, 1);
+	g.insert_edge(dest, src, 2);
+	auto const allocations = resource.allocations;
+	auto length = std::size_t{0};
+	for (auto const& [from, to, weight] : g) {
+		length += from.size() + to.size() + static_cast<std::size_t>(weight);
+	}
+	CHECK(length == 2 * (src.size() + dest.size()) + 3);
+	CHECK(resource.allocations == allocations);
+}
@@ -40,8 +40,8 @@ For iterator comparasion, we check if iterator pointing to the same edge are equ
 
 Iterator begin and end are tested to ensure they points to correct edge.
 
-The returned value_type is just a copy rather than the actual data in
-the graph, so all the above functions should work on both const and non-const graph.
+Dereferencing returns read-only references to the data in the graph,
+so all the above functions should work on both const and non-const graph.
 
 Extractor && comparasion
 ------------------------
@@ -110,6 +110,46 @@ TEST_CASE("InputIt constructor") {
 	}
 }
 
+TEST_CASE("Bulk load constructor") {
+	using graph = gdwg::graph<std::string, int>;
+	auto const nodes = std::vector<std::string>{"are", "how", "you"};
+
+	SECTION("Sorted edges") {
+		auto const edges = std::vector<graph::value_type>{{"are", "you", 3},
+		                                                  {"how", "are", 1},
+		                                                  {"how", "you", 2},
+		                                                  {"how", "you", 4}};
+		auto g = graph(nodes.begin(), nodes.end(), edges.begin(), edges.end());
+		CHECK(g.nodes() == nodes);
+		CHECK(g.weights("how", "you") == std::vector<int>{2, 4});
+		CHECK(g.is_connected("are", "you"));
+		CHECK(g.is_connected("how", "are"));
+		CHECK(g.erase_node("you"));
+		CHECK(g.connections("how") == std::vector<std::string>{"are"});
+	}
+
+	SECTION("Unsorted edges with duplicates") {
+		auto const edges = std::vector<graph::value_type>{{"you", "how", 2},
+		                                                  {"how", "are", 1},
+		                                                  {"you", "how", 2},
+		                                                  {"are", "are", 5}};
+		auto const g = graph(nodes.rbegin(), nodes.rend(), edges.begin(), edges.end());
+		auto expected = graph{"are", "how", "you"};
+		expected.insert_edge("you", "how", 2);
+		expected.insert_edge("how", "are", 1);
+		expected.insert_edge("are", "are", 5);
+		CHECK(g == expected);
+	}
+
+	SECTION("Exception: either src or dst node does not exist") {
+		auto const edges = std::vector<graph::value_type>{{"how", "hello", 1}};
+		CHECK_THROWS_MATCHES(graph(nodes.begin(), nodes.end(), edges.begin(), edges.end()),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::insert_edges "
+		                                              "when either src or dst node does not exist"));
+	}
+}
+
 TEST_CASE("Move constructor") {
 	// move-from graph
 	auto g = gdwg::graph<std::string, int>{"hello", "how", "are"};
@@ -212,6 +252,13 @@ TEST_CASE("Copy constructor") {
 	CHECK(g.is_connected("how", "are"));
 	CHECK_FALSE(g2.is_node("good"));
 	CHECK_FALSE(g2.is_connected("how", "are"));
+
+	// g2 owns its own edges, including the incoming ones of each node
+	CHECK(g2.erase_node("how"));
+	CHECK(g.weights("hello", "how") == std::vector<int>{5});
+	CHECK(g2.erase_node("are"));
+	CHECK(g2.connections("hello").empty());
+	CHECK(g.connections("hello") == std::vector<std::string>{"are", "how"});
 }
 
 TEST_CASE("Copy assignment") {
@@ -1,5 +1,16 @@
 #include "gdwg/graph.hpp"
 #include <catch2/catch.hpp>
+#include <algorithm>
+#include <compare>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 TEST_CASE("Extractor <<") {
 	SECTION("Empty") {
@@ -70,6 +81,26 @@ you (
 )
 64 (
 )
+)");
+		CHECK(out.str() == expect);
+	}
+
+	SECTION("Appends to the stream and can be chained") {
+		auto g = gdwg::graph<int, int>{3, 1, 2};
+		g.insert_edge(3, 1, 0);
+		g.insert_edge(1, 1, 2);
+		auto out = std::ostringstream{};
+		out << "before\n" << g << "after\n";
+		auto const expect = std::string_view(R"(before
+1 (
+  1 | 2
+)
+2 (
+)
+3 (
+  1 | 0
+)
+after
 )");
 		CHECK(out.str() == expect);
 	}
@@ -123,3 +154,162 @@ TEST_CASE("Comparison") {
 		CHECK_FALSE(g1 == g2);
 	}
 }
+
+namespace {
+	struct unhashable {
+		int value;
+		auto operator<=>(unhashable const&) const = default;
+	};
+} // namespace
+
+TEST_CASE("Hashing") {
+	using graph = gdwg::graph<std::string, int>;
+	auto const hash = std::hash<graph>{};
+	auto g1 = graph{"how", "are", "you"};
+	g1.insert_edge("how", "you", 1);
+	g1.insert_edge("how", "how", 2);
+	g1.insert_edge("are", "you", 3);
+
+	SECTION("Equal graphs hash equal however they were built") {
+		auto g2 = graph{"you", "?", "are"};
+		g2.insert_edge("are", "you", 3);
+		g2.insert_edge("?", "?", 2);
+		g2.insert_edge("?", "you", 1);
+		g2.insert_edge("?", "are", 4);
+		g2.erase_edge("?", "are", 4);
+		g2.replace_node("?", "how");
+		g2.insert_node("hello");
+		g2.merge_replace_node("hello", "how");
+		REQUIRE(g1 == g2);
+		CHECK(hash(g1) == hash(g2));
+
+		auto const copy = g1;
+		CHECK(hash(copy) == hash(g1));
+		auto moved = std::move(g2);
+		CHECK(hash(moved) == hash(g1));
+		// NOLINTNEXTLINE(bugprone-use-after-move)
+		CHECK(hash(g2) == hash(graph{}));
+		g2 = copy;
+		CHECK(hash(g2) == hash(g1));
+		g2.clear();
+		CHECK(hash(g2) == hash(graph{}));
+	}
+
+	SECTION("Graphs that differ hash differently") {
+		auto g2 = g1;
+		g2.erase_edge("how", "you", 1);
+		g2.insert_edge("you", "how", 1);
+		CHECK_FALSE(g1 == g2);
+		CHECK(hash(g1) != hash(g2));
+		auto const ints = std::hash<gdwg::graph<int, int>>{};
+		CHECK(ints(gdwg::graph<int, int>{1, 4}) != ints(gdwg::graph<int, int>{2, 3}));
+	}
+
+	SECTION("Graphs can be kept in unordered containers") {
+		auto g2 = g1;
+		g2.insert_node("?");
+		auto seen = std::unordered_set<graph>{g1, g2, graph{}};
+		CHECK(seen.size() == 3);
+		g2.erase_node("?");
+		CHECK_FALSE(seen.insert(g2).second);
+		CHECK(seen.contains(graph{}));
+	}
+
+	SECTION("Only graphs of hashable types have a hash") {
+		static_assert(not std::is_default_constructible_v<std::hash<gdwg::graph<unhashable, int>>>);
+		auto u1 = gdwg::graph<unhashable, int>{{1}, {2}};
+		auto u2 = gdwg::graph<unhashable, int>{{2}, {1}};
+		u1.insert_edge({1}, {2}, 3);
+		CHECK_FALSE((u1 == u2));
+		u2.insert_edge({1}, {2}, 3);
+		CHECK((u1 == u2));
+	}
+}
+
+TEST_CASE("Equality does not depend on insertion order") {
+	using graph = gdwg::graph<std::string, int>;
+	auto rng = std::mt19937{4242};
+	auto names = std::vector<std::string>{};
+	for (auto i = 0; i < 60; ++i) {
+		names.push_back("node " + std::to_string(i));
+	}
+	auto pick = std::uniform_int_distribution<std::size_t>{0, names.size() - 1};
+	auto edges = std::vector<graph::value_type>{};
+	for (auto i = 0; i < 400; ++i) {
+		edges.emplace_back(names[pick(rng)], names[pick(rng)], i % 7);
+	}
+	names.push_back("isolated");
+	auto const build = [&names](std::vector<graph::value_type> const& order) {
+		auto g = graph(names.rbegin(), names.rend());
+		for (auto const& [from, to, weight] : order) {
+			g.insert_edge(from, to, weight);
+		}
+		return g;
+	};
+	auto const original = build(edges);
+
+	SECTION("Shuffled insertions") {
+		for (auto i = 0; i < 5; ++i) {
+			std::shuffle(edges.begin(), edges.end(), rng);
+			CHECK(build(edges) == original);
+		}
+	}
+
+	SECTION("Bulk loads, copies and round trips") {
+		auto sorted = std::vector<graph::value_type>(original.begin(), original.end());
+		CHECK(graph(names.begin(), names.end(), sorted.begin(), sorted.end()) == original);
+		auto g = original;
+		CHECK(g == original);
+		g.replace_node("node 7", "renamed");
+		CHECK_FALSE(g == original);
+		g.replace_node("renamed", "node 7");
+		CHECK(g == original);
+		auto const& [from, to, weight] = *original.begin();
+		g.erase_edge(from, to, weight);
+		CHECK_FALSE(g == original);
+		g.insert_edge(from, to, weight);
+		CHECK(g == original);
+		g.insert_node("extra");
+		g.erase_node("extra");
+		CHECK(g == original);
+	}
+
+	SECTION("Same sizes, different contents") {
+		// Every pair below agrees on the node count, edge count and every out-degree.
+		auto const differ_in = [&](auto change) {
+			auto g = original;
+			change(g);
+			CHECK(g.num_nodes() == original.num_nodes());
+			CHECK(g.num_edges() == original.num_edges());
+			CHECK_FALSE(g == original);
+			CHECK_FALSE(original == g);
+		};
+		auto const& [from, to, weight] = *std::prev(original.end());
+		differ_in([&](graph& g) {
+			g.erase_edge(from, to, weight);
+			g.insert_edge(from, to, weight + 10);
+		});
+		differ_in([&](graph& g) {
+			g.erase_edge(from, to, weight);
+			g.insert_edge(from, to == "node 0" ? "node 1" : "node 0", weight + 10);
+		});
+		differ_in([](graph& g) {
+			g.erase_node("isolated");
+			g.insert_node("a new name");
+		});
+	}
+
+	SECTION("Graphs without a content hash") {
+		auto u1 = gdwg::graph<unhashable, int>{{1}, {2}, {3}};
+		auto u2 = gdwg::graph<unhashable, int>{{3}, {2}, {1}};
+		u1.insert_edge({1}, {2}, 0);
+		u1.insert_edge({1}, {3}, 0);
+		u2.insert_edge({1}, {3}, 0);
+		CHECK_FALSE((u1 == u2));
+		u2.insert_edge({1}, {2}, 0);
+		CHECK((u1 == u2));
+		u1.insert_edge({2}, {1}, 0);
+		u2.insert_edge({2}, {3}, 0);
+		CHECK_FALSE((u1 == u2));
+	}
+}
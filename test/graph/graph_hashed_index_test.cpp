@@ -0,0 +1,136 @@
+#include "gdwg/graph.hpp"
+#include <catch2/catch.hpp>
+#include <memory_resource>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+	template<typename N, typename E>
+	using hashed_graph = gdwg::graph<N, E, std::allocator<std::byte>, gdwg::hashed_index>;
+
+	template<typename G>
+	auto to_string(G const& g) -> std::string {
+		auto out = std::ostringstream{};
+		out << g;
+		return out.str();
+	}
+} // namespace
+
+TEST_CASE("Hashed index") {
+	auto g = hashed_graph<std::string, int>{"how", "are", "you"};
+	g.insert_edge("how", "are", 1);
+	g.insert_edge("how", "you", 2);
+	g.insert_edge("are", "you", 3);
+
+	SECTION("Lookups") {
+		CHECK(g.is_node("how"));
+		CHECK_FALSE(g.is_node("?"));
+		CHECK(g.is_connected("how", "you"));
+		CHECK(g.weights("how", "you") == std::vector<int>{2});
+		CHECK(g.connections("how") == std::vector<std::string>{"are", "you"});
+		CHECK(g.find("are", "you", 3) != g.end());
+		CHECK(g.find_node("you").has_value());
+		CHECK_FALSE(g.insert_node("how"));
+	}
+
+	SECTION("Output stays sorted") {
+		g.insert_node("?");
+		CHECK(g.nodes() == std::vector<std::string>{"?", "are", "how", "you"});
+		CHECK(to_string(g)
+		      == "? (\n)\nare (\n  you | 3\n)\nhow (\n  are | 1\n  you | 2\n)\nyou (\n)\n");
+	}
+
+	SECTION("Replace, merge and erase keep the index in step") {
+		CHECK(g.replace_node("how", "why"));
+		CHECK_FALSE(g.is_node("how"));
+		CHECK(g.is_node("why"));
+		g.merge_replace_node("are", "you");
+		CHECK_FALSE(g.is_node("are"));
+		CHECK(g.connections("why") == std::vector<std::string>{"you"});
+		CHECK(g.erase_node("you"));
+		CHECK_FALSE(g.is_node("you"));
+		CHECK(g.insert_node("you"));
+		CHECK(g.is_node("you"));
+	}
+
+	SECTION("Copies and moves carry their own index") {
+		auto copy = g;
+		copy.erase_node("how");
+		CHECK(g.is_node("how"));
+		CHECK_FALSE(copy.is_node("how"));
+
+		auto moved = std::move(g);
+		CHECK(moved.is_node("how"));
+		CHECK_FALSE(g.is_node("how"));
+		g.insert_node("how");
+		CHECK(g.is_node("how"));
+
+		copy = std::move(moved);
+		CHECK(copy.is_node("how"));
+		CHECK(copy.is_connected("how", "are"));
+	}
+
+	SECTION("Clear") {
+		g.clear();
+		CHECK_FALSE(g.is_node("how"));
+		CHECK(g.insert_node("how"));
+		CHECK(g.is_node("how"));
+	}
+
+	SECTION("Allocates through the graph's allocator") {
+		auto buffer = std::vector<std::byte>(1 << 16);
+		auto arena = std::pmr::monotonic_buffer_resource(buffer.data(),
+		                                                 buffer.size(),
+		                                                 std::pmr::null_memory_resource());
+		auto pmr_graph = gdwg::pmr::graph<int, int, gdwg::hashed_index>(&arena);
+		for (auto i = 0; i < 100; ++i) {
+			pmr_graph.insert_node(i);
+		}
+		CHECK(pmr_graph.is_node(99));
+	}
+}
+
+TEST_CASE("Hashed index matches the ordered graph on random operations") {
+	auto ordered = gdwg::graph<int, int>{};
+	auto hashed = hashed_graph<int, int>{};
+	auto rng = std::mt19937{515};
+	auto value = std::uniform_int_distribution<int>{0, 199};
+	auto operation = std::uniform_int_distribution<int>{0, 9};
+	for (auto step = 0; step < 20000; ++step) {
+		auto const a = value(rng);
+		auto const b = value(rng);
+		switch (operation(rng)) {
+		case 0:
+		case 1:
+		case 2: REQUIRE(hashed.insert_node(a) == ordered.insert_node(a)); break;
+		case 3:
+		case 4:
+		case 5:
+			if (ordered.is_node(a) and ordered.is_node(b)) {
+				REQUIRE(hashed.insert_edge(a, b, step % 7) == ordered.insert_edge(a, b, step % 7));
+			}
+			break;
+		case 6: REQUIRE(hashed.erase_node(a) == ordered.erase_node(a)); break;
+		case 7:
+			if (ordered.is_node(a)) {
+				REQUIRE(hashed.replace_node(a, b) == ordered.replace_node(a, b));
+			}
+			break;
+		case 8:
+			if (ordered.is_node(a) and ordered.is_node(b)) {
+				hashed.merge_replace_node(a, b);
+				ordered.merge_replace_node(a, b);
+			}
+			break;
+		default: REQUIRE(hashed.is_node(a) == ordered.is_node(a)); break;
+		}
+	}
+	CHECK(hashed.nodes() == ordered.nodes());
+	CHECK(to_string(hashed) == to_string(ordered));
+	for (auto const& n : ordered.nodes()) {
+		CHECK(hashed.connections(n) == ordered.connections(n));
+	}
+}
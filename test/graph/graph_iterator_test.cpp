@@ -1,5 +1,13 @@
 #include "gdwg/graph.hpp"
 #include <catch2/catch.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <random>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 TEST_CASE("Iterator test") {
 	auto g = gdwg::graph<std::string, int>{"how", "are", "you"};
@@ -74,6 +82,21 @@ TEST_CASE("Iterator test") {
 		CHECK((*it).weight == 1);
 	}
 
+	SECTION("Dereferencing refers into the graph") {
+		static_assert(std::bidirectional_iterator<gdwg::graph<std::string, int>::iterator>);
+		auto const& [from, to, weight] = *const_g.find("how", "you", 2);
+		static_assert(std::is_same_v<decltype(from), std::string const&>);
+		static_assert(std::is_same_v<decltype(weight), int const&>);
+		CHECK(weight == 2);
+		// Edges share their endpoints' node values rather than holding copies.
+		CHECK(&from == &(*const_g.find("how", "are", 1)).from);
+		CHECK(&to == &(*const_g.begin()).to);
+		gdwg::graph<std::string, int>::value_type const copy = *const_g.begin();
+		CHECK(copy.from == "are");
+		CHECK(copy.to == "you");
+		CHECK(copy.weight == 3);
+	}
+
 	SECTION("Iterator comparison") {
 		auto it = g.begin();
 		// check equality
@@ -97,3 +120,97 @@ TEST_CASE("Iterator test") {
 		CHECK_FALSE(g.find("how", "are", 1) == g.begin());
 	}
 }
+
+TEST_CASE("Edge partitions") {
+	using graph = gdwg::graph<int, int>;
+	using edge = std::tuple<int, int, int>;
+	auto const edges_of = [](graph::iterator first, graph::iterator last) {
+		auto edges = std::vector<edge>{};
+		for (auto it = first; it != last; ++it) {
+			auto const& [from, to, weight] = *it;
+			edges.emplace_back(from, to, weight);
+		}
+		return edges;
+	};
+	// Every edge lands in exactly one partition, in order; no source is split between two; and no
+	// partition exceeds an even share by more than the largest out-degree.
+	auto const check = [&edges_of](graph const& g, std::size_t k) {
+		auto const partitions = g.edge_partitions(k);
+		REQUIRE(partitions.size() == k);
+		auto const expected = edges_of(g.begin(), g.end());
+		auto max_degree = std::size_t{0};
+		for (auto first = expected.begin(); first != expected.end();) {
+			auto const last = std::find_if(first, expected.end(), [first](edge const& e) {
+				return std::get<0>(e) != std::get<0>(*first);
+			});
+			max_degree = std::max(max_degree, static_cast<std::size_t>(last - first));
+			first = last;
+		}
+		auto covered = std::vector<edge>{};
+		for (auto const& partition : partitions) {
+			auto const edges = edges_of(partition.begin(), partition.end());
+			CHECK(edges.size() <= expected.size() / k + 1 + max_degree);
+			covered.insert(covered.end(), edges.begin(), edges.end());
+			if (partition.begin() != g.begin() and partition.begin() != g.end()) {
+				CHECK((*std::prev(partition.begin())).from != (*partition.begin()).from);
+			}
+		}
+		CHECK(covered == expected);
+	};
+
+	// Out-degrees from 0 to 29 and one hub, over nodes spread out so some have no edges.
+	auto g = graph{};
+	auto rng = std::mt19937{1729};
+	auto node = std::uniform_int_distribution<int>{0, 299};
+	for (auto i = 0; i < 300; ++i) {
+		g.insert_node(i);
+	}
+	for (auto src = 0; src < 300; src += 3) {
+		for (auto i = 0; i < src % 30; ++i) {
+			g.insert_edge(src, node(rng), i);
+		}
+	}
+	for (auto i = 0; i < 200; ++i) {
+		g.insert_edge(150, node(rng), i);
+	}
+
+	SECTION("Cover every edge once, split by source") {
+		for (auto const k : {1, 2, 3, 8, 64, 101, 1000}) {
+			check(g, static_cast<std::size_t>(k));
+		}
+		auto const halves = g.edge_partitions(2);
+		CHECK(halves[0].begin() == g.begin());
+		CHECK(halves[1].end() == g.end());
+	}
+
+	SECTION("Follow changes to the graph") {
+		g.erase_node(150);
+		g.merge_replace_node(3, 6);
+		g.replace_node(9, 1000);
+		auto erased = std::vector<graph::value_type>{};
+		for (auto const& [from, to, weight] : g) {
+			if ((from + to + weight) % 4 == 0) {
+				erased.emplace_back(from, to, weight);
+			}
+		}
+		g.erase_edges(erased.begin(), erased.end());
+		for (auto const k : {1, 5, 16}) {
+			check(g, static_cast<std::size_t>(k));
+		}
+		check(graph(g), 7);
+	}
+
+	SECTION("Empty graphs") {
+		for (auto const& partition : graph{}.edge_partitions(4)) {
+			CHECK(partition.empty());
+		}
+		check(graph{1, 2, 3}, 2);
+	}
+
+	SECTION("Exception: zero partitions") {
+		CHECK_THROWS_MATCHES(g.edge_partitions(0),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::"
+		                                              "edge_partitions with zero partitions"));
+	}
+}
@@ -1,8 +1,29 @@
 #include "gdwg/graph.hpp"
 #include <catch2/catch.hpp>
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <random>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+	// An int that counts how often it is compared with <.
+	struct counted {
+		int value;
+		static inline auto comparisons = 0;
+
+		auto operator<(counted const& other) const -> bool {
+			++comparisons;
+			return value < other.value;
+		}
+
+		auto operator==(counted const& other) const -> bool = default;
+	};
+} // namespace
 
 TEST_CASE("Insert node") {
 	SECTION("Stored in heap") {
@@ -97,6 +118,60 @@ TEST_CASE("Insert edge") {
 	}
 }
 
+TEST_CASE("Insert edges") {
+	using graph = gdwg::graph<int, int>;
+	auto g = graph{1, 2, 3, 4};
+	g.insert_edge(2, 3, 0);
+
+	SECTION("Counts only new edges") {
+		auto const edges = std::vector<graph::value_type>{{1, 2, 1}, {2, 3, 0}, {2, 3, 1}, {4, 1, 2}};
+		CHECK(g.insert_edges(edges.begin(), edges.end()) == 3);
+		CHECK(g.weights(2, 3) == std::vector<int>{0, 1});
+		CHECK(g.insert_edges(edges.begin(), edges.end()) == 0);
+	}
+
+	SECTION("Matches repeated insert_edge") {
+		auto edges = std::vector<graph::value_type>{};
+		for (auto src = 1; src <= 4; ++src) {
+			for (auto dest = 1; dest <= 4; ++dest) {
+				edges.emplace_back(src, dest, src * dest);
+			}
+		}
+		auto expected = g;
+		std::for_each(edges.begin(), edges.end(), [&](graph::value_type const& e) {
+			expected.insert_edge(e.from, e.to, e.weight);
+		});
+		auto sorted = g;
+		sorted.insert_edges(edges.begin(), edges.end());
+		CHECK(sorted == expected);
+		auto reversed = g;
+		reversed.insert_edges(edges.rbegin(), edges.rend());
+		CHECK(reversed == expected);
+		CHECK(reversed.erase_node(3));
+		CHECK(reversed.connections(2) == std::vector<int>{1, 2, 4});
+	}
+
+	SECTION("Exception: either src or dst node does not exist") {
+		auto const edges = std::vector<graph::value_type>{{1, 2, 1}, {1, 5, 1}};
+		CHECK_THROWS_MATCHES(g.insert_edges(edges.begin(), edges.end()),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::insert_edges "
+		                                              "when either src or dst node does not exist"));
+	}
+
+	SECTION("Sorted sources skip nodes without edges and find missing ones") {
+		auto sparse = graph{1, 3, 5, 7};
+		auto const edges = std::vector<graph::value_type>{{1, 7, 1}, {5, 3, 2}, {7, 1, 3}, {3, 5, 4}};
+		CHECK(sparse.insert_edges(edges.begin(), edges.end()) == 4);
+		CHECK(sparse.connections(5) == std::vector<int>{3});
+		CHECK(sparse.connections(3) == std::vector<int>{5});
+		auto const between = std::vector<graph::value_type>{{1, 3, 5}, {4, 3, 5}};
+		CHECK_THROWS_AS(sparse.insert_edges(between.begin(), between.end()), std::runtime_error);
+		auto const after = std::vector<graph::value_type>{{7, 3, 5}, {8, 3, 5}};
+		CHECK_THROWS_AS(sparse.insert_edges(after.begin(), after.end()), std::runtime_error);
+	}
+}
+
 TEST_CASE("Replace node") {
 	auto g = gdwg::graph<std::string, int>();
 	SECTION("New data does not exist") {
@@ -264,6 +339,172 @@ TEST_CASE("Erase node") {
 	}
 }
 
+TEST_CASE("Node ids") {
+	auto g = gdwg::graph<std::string, int>{"how", "are"};
+	auto const [you, inserted] = g.emplace_node("you");
+	auto const how = g.find_node("how");
+	auto const are = g.find_node("are");
+	REQUIRE(how.has_value());
+	REQUIRE(are.has_value());
+
+	SECTION("Insert and find") {
+		CHECK(inserted);
+		CHECK(g.node_value(you) == "you");
+		CHECK(g.find_node("you") == you);
+		CHECK(g.emplace_node("how") == std::pair(*how, false));
+		CHECK(g.find_node("hello") == std::nullopt);
+	}
+
+	SECTION("Insert edge and query by id") {
+		CHECK(g.insert_edge_by_id(*how, you, 2));
+		CHECK(g.insert_edge_by_id(*how, you, 1));
+		CHECK_FALSE(g.insert_edge_by_id(*how, you, 2));
+		CHECK(g.insert_edge_by_id(*how, *are, 3));
+		CHECK(g.insert_edge_by_id(*how, *how, 4));
+		CHECK(g.weights("how", "you") == std::vector<int>{1, 2});
+		CHECK(g.weights_by_id(*how, you) == std::vector<int>{1, 2});
+		CHECK(g.weights_by_id(you, *how).empty());
+		CHECK(g.connections_by_id(*how) == std::vector{*are, *how, you});
+		CHECK(g.connections_by_id(you).empty());
+	}
+
+	SECTION("Ids stay valid while other nodes change") {
+		g.insert_edge("you", "are", 1);
+		g.insert_edge("are", "how", 2);
+		g.erase_node("how");
+		g.insert_node("hello");
+		g.replace_node("are", "aren't");
+		CHECK(g.node_value(you) == "you");
+		CHECK(g.connections("you") == std::vector<std::string>{"aren't"});
+	}
+
+	SECTION("By-id queries follow other modifiers") {
+		g.insert_node("hello");
+		g.insert_edge("how", "you", 1);
+		g.insert_edge("how", "are", 2);
+		g.insert_edge("you", "how", 3);
+		g.insert_edge("are", "hello", 4);
+		g.insert_edge("hello", "how", 5);
+		g.replace_node("how", "why");
+		g.merge_replace_node("hello", "you");
+		CHECK(g.erase_edge("are", "you", 4));
+		g.insert_edge("why", "why", 6);
+		auto const copy = g;
+		for (auto const& graph : {g, copy}) {
+			for (auto const& value : graph.nodes()) {
+				auto const id = *graph.find_node(value);
+				auto values = std::vector<std::string>();
+				for (auto const to : graph.connections_by_id(id)) {
+					values.push_back(graph.node_value(to));
+					CHECK(graph.weights_by_id(id, to) == graph.weights(value, values.back()));
+				}
+				CHECK(values == graph.connections(value));
+			}
+		}
+	}
+
+	SECTION("Erase node by id") {
+		g.insert_edge("how", "you", 1);
+		g.insert_edge("you", "are", 2);
+		g.insert_edge("you", "you", 3);
+		g.erase_node_by_id(you);
+		CHECK_FALSE(g.is_node("you"));
+		CHECK(g.connections("how").empty());
+		CHECK(g.begin() == g.end());
+	}
+
+	SECTION("Erase node by id compares no values") {
+		auto counted_graph = gdwg::graph<counted, int>{{1}, {2}, {3}, {5}, {6}};
+		auto const id = counted_graph.emplace_node({4}).first;
+		counted_graph.insert_edge({4}, {1}, 1);
+		counted_graph.insert_edge({4}, {6}, 2);
+		counted_graph.insert_edge({4}, {4}, 3);
+		counted_graph.insert_edge({2}, {4}, 4);
+		counted_graph.insert_edge({6}, {4}, 5);
+		counted_graph.insert_edge({1}, {2}, 6);
+		counted::comparisons = 0;
+		counted_graph.erase_node_by_id(id);
+		CHECK(counted::comparisons == 0);
+		CHECK(counted_graph.nodes().size() == 5);
+		CHECK_FALSE(counted_graph.is_node({4}));
+		CHECK(std::distance(counted_graph.begin(), counted_graph.end()) == 1);
+		CHECK(counted_graph.is_connected({1}, {2}));
+		CHECK(counted_graph.connections({2}).empty());
+		CHECK(counted_graph.connections({6}).empty());
+	}
+}
+
+TEST_CASE("Incoming edges are tracked through modifiers") {
+	auto g = gdwg::graph<std::string, int>{"how", "are", "you"};
+	g.insert_edge("how", "are", 1);
+	g.insert_edge("are", "you", 2);
+	g.insert_edge("you", "are", 3);
+	g.insert_edge("are", "are", 4);
+	auto const expected = std::string_view(R"(how (
+)
+you (
+)
+)");
+
+	SECTION("After replace node") {
+		CHECK(g.replace_node("are", "hello"));
+		CHECK(g.erase_node("hello"));
+		auto oss = std::ostringstream{};
+		oss << g;
+		CHECK(oss.str() == expected);
+	}
+
+	SECTION("After merge replace node") {
+		g.insert_edge("how", "you", 3);
+		g.merge_replace_node("you", "are");
+		CHECK(g.weights("are", "are") == std::vector<int>{2, 3, 4});
+		CHECK(g.weights("how", "are") == std::vector<int>{1, 3});
+		g.insert_node("you");
+		CHECK(g.erase_node("are"));
+		auto oss = std::ostringstream{};
+		oss << g;
+		CHECK(oss.str() == expected);
+	}
+
+	SECTION("After erase edge by iterator") {
+		g.erase_edge(g.find("how", "are", 1));
+		g.erase_edge(g.find("are", "are", 4), g.end());
+		CHECK(g.erase_node("are"));
+		auto oss = std::ostringstream{};
+		oss << g;
+		CHECK(oss.str() == expected);
+	}
+
+	SECTION("After copy") {
+		auto copy = g;
+		CHECK(copy.erase_node("are"));
+		auto oss = std::ostringstream{};
+		oss << copy;
+		CHECK(oss.str() == expected);
+		CHECK(g.weights("you", "are") == std::vector<int>{3});
+	}
+
+	SECTION("After move") {
+		auto moved = std::move(g);
+		CHECK(moved.erase_node("are"));
+		auto oss = std::ostringstream{};
+		oss << moved;
+		CHECK(oss.str() == expected);
+	}
+
+	SECTION("After clear") {
+		g.clear();
+		g.insert_node("how");
+		g.insert_node("are");
+		g.insert_node("you");
+		g.insert_edge("how", "are", 1);
+		CHECK(g.erase_node("are"));
+		auto oss = std::ostringstream{};
+		oss << g;
+		CHECK(oss.str() == expected);
+	}
+}
+
 TEST_CASE("Erase edge (src, dst, weight)") {
 	auto g = gdwg::graph<std::string, int>{"how", "are", "you"};
 	g.insert_edge("how", "are", 1);
@@ -300,6 +541,79 @@ TEST_CASE("Erase edge (src, dst, weight)") {
 	}
 }
 
+TEST_CASE("Erase edges") {
+	using graph = gdwg::graph<std::string, int>;
+	auto g = graph{"how", "are", "you"};
+	g.insert_edge("how", "are", 1);
+	g.insert_edge("how", "are", 2);
+	g.insert_edge("are", "you", 2);
+	g.insert_edge("you", "how", 3);
+	g.insert_edge("how", "how", 4);
+
+	SECTION("Counts only erased edges, in any order") {
+		auto const edges = std::vector<graph::value_type>{{"you", "how", 3},
+		                                                  {"how", "are", 2},
+		                                                  {"how", "are", 5},
+		                                                  {"you", "how", 3},
+		                                                  {"how", "are", 1}};
+		CHECK(g.erase_edges(edges.begin(), edges.end()) == 3);
+		CHECK_FALSE(g.is_connected("how", "are"));
+		CHECK_FALSE(g.is_connected("you", "how"));
+		CHECK(g.is_connected("are", "you"));
+		CHECK(g.erase_edges(edges.begin(), edges.end()) == 0);
+		CHECK(g.connections("how") == std::vector<std::string>{"how"});
+	}
+
+	SECTION("Matches repeated erase_edge") {
+		auto rng = std::mt19937{1201};
+		auto node = std::uniform_int_distribution<int>{0, 19};
+		auto big = gdwg::graph<int, int>{};
+		for (auto i = 0; i < 20; ++i) {
+			big.insert_node(i);
+		}
+		auto requests = std::vector<gdwg::graph<int, int>::value_type>{};
+		for (auto i = 0; i < 400; ++i) {
+			big.insert_edge(node(rng), node(rng), i % 4);
+			requests.emplace_back(node(rng), node(rng), i % 5);
+		}
+		auto expected = big;
+		auto erased = std::size_t{0};
+		for (auto const& e : requests) {
+			erased += expected.erase_edge(e.from, e.to, e.weight) ? 1 : 0;
+		}
+		CHECK(big.erase_edges(requests.begin(), requests.end()) == erased);
+		CHECK(big == expected);
+		for (auto i = 0; i < 20; ++i) {
+			CHECK(big.connections(i) == expected.connections(i));
+		}
+	}
+
+	SECTION("Takes a graph's own edges") {
+		auto const copy = g;
+		CHECK(g.erase_edges(copy.begin(), copy.end()) == 5);
+		CHECK(g.begin() == g.end());
+		CHECK(g.nodes() == copy.nodes());
+	}
+
+	SECTION("Takes stored references, which only convert to value_type") {
+		auto const copy = g;
+		auto const refs = std::vector<graph::reference>(copy.begin(), copy.end());
+		CHECK(g.erase_edges(refs.begin(), refs.end()) == 5);
+		CHECK(g.begin() == g.end());
+		CHECK(g.erase_edges(refs.begin(), refs.end()) == 0);
+	}
+
+	SECTION("Exception: either src or dst node does not exist, nothing erased") {
+		auto const edges = std::vector<graph::value_type>{{"how", "are", 1}, {"how", "hello", 1}};
+		auto const before = g;
+		CHECK_THROWS_MATCHES(g.erase_edges(edges.begin(), edges.end()),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::graph<N, E>::erase_edges on "
+		                                              "src or dst if they don't exist in the graph"));
+		CHECK(g == before);
+	}
+}
+
 TEST_CASE("Erase edge (iterator)") {
 	auto g = gdwg::graph<std::string, int>{"how", "are", "you"};
 
@@ -327,7 +641,8 @@ TEST_CASE("Erase edge (iterator, iterator)") {
 	SECTION("erase single edge") {
 		g.insert_edge("how", "are", 1);
 		g.insert_edge("are", "you", 2);
-		CHECK(g.erase_edge(g.begin(), g.find("how", "are", 2)) == g.find("how", "are", 1));
+		auto it = g.erase_edge(g.begin(), g.find("how", "are", 2));
+		CHECK(it == g.find("how", "are", 1));
 		CHECK(g.erase_edge(g.begin(), g.end()) == g.end());
 	}
 
@@ -0,0 +1,147 @@
+#include "gdwg/parse_graph.hpp"
+#include <catch2/catch.hpp>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace {
+	template<typename N, typename E>
+	auto round_trip(gdwg::graph<N, E> const& g) -> gdwg::graph<N, E> {
+		auto out = std::stringstream{};
+		out << g;
+		auto result = gdwg::graph<N, E>{};
+		out >> result;
+		CHECK(out.eof());
+		CHECK_FALSE(out.fail());
+		return result;
+	}
+} // namespace
+
+TEST_CASE("Extractor >>") {
+	SECTION("Empty") {
+		CHECK(round_trip(gdwg::graph<std::string, int>{}).empty());
+	}
+
+	SECTION("Round trip") {
+		auto g = gdwg::graph<std::string, int>{"how", "are", "you", "?"};
+		g.insert_edge("how", "are", 1);
+		g.insert_edge("how", "you", 2);
+		g.insert_edge("how", "you", -5);
+		g.insert_edge("are", "you", 3);
+		g.insert_edge("you", "?", 4);
+		CHECK(round_trip(g) == g);
+	}
+
+	SECTION("Values with spaces and separators") {
+		auto g = gdwg::graph<std::string, std::string>{"a (b)", "c | d", ""};
+		g.insert_edge("a (b)", "c | d", "x y");
+		g.insert_edge("", "", "z");
+		CHECK(round_trip(g) == g);
+	}
+
+	SECTION("Floating point weights") {
+		auto g = gdwg::graph<int, double>{1, 2, -3};
+		g.insert_edge(1, 2, 0.5);
+		g.insert_edge(1, 2, -0.25);
+		g.insert_edge(-3, 1, 1e-3);
+		CHECK(round_trip(g) == g);
+	}
+
+	SECTION("Character nodes") {
+		auto g = gdwg::graph<char, int>{'a', 'b', ' '};
+		g.insert_edge('a', ' ', 1);
+		CHECK(round_trip(g) == g);
+	}
+
+	SECTION("Input larger than a chunk") {
+		auto g = gdwg::graph<int, int>{};
+		for (auto i = 0; i < 20000; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < 20000; ++i) {
+			for (auto j = 1; j <= 5; ++j) {
+				g.insert_edge(i, (i * j) % 20000, i - j);
+			}
+		}
+		CHECK(round_trip(g) == g);
+
+		auto const name = std::string(3 << 20, 'x');
+		auto const long_names = gdwg::graph<std::string, int>{name, "y"};
+		CHECK(round_trip(long_names) == long_names);
+	}
+
+	SECTION("Keeps the graph's allocator") {
+		auto resource = std::pmr::monotonic_buffer_resource{};
+		auto g = gdwg::pmr::graph<int, int>(&resource);
+		auto in = std::istringstream("1 (\n  1 | 2\n)\n");
+		in >> g;
+		CHECK(g.get_allocator().resource() == &resource);
+		CHECK(g.is_connected(1, 1));
+	}
+
+	SECTION("Malformed input sets failbit and leaves the graph alone") {
+		auto const original = gdwg::graph<int, int>{1, 2};
+		auto const check_fails = [&](std::string_view text) {
+			auto g = original;
+			auto in = std::istringstream(std::string(text));
+			in >> g;
+			CHECK(in.fail());
+			CHECK(g == original);
+		};
+		check_fails("1 (\n  2 | 3\n");
+		check_fails("1\n)\n");
+		check_fails("1 (\n  2 3\n)\n");
+		check_fails("1 (\n  2 | x\n)\n");
+		check_fails("one (\n)\n");
+		check_fails("1 (\n  2 | 3\n)\n");
+	}
+}
+
+TEST_CASE("Parse graph") {
+	SECTION("Edge list") {
+		auto in = std::istringstream("how are 1\nhow you 2\n\n  you you\t4 are\nyou 3 how  are 1");
+		auto const g = gdwg::parse_graph<std::string, int>(in, gdwg::graph_format::edge_list);
+		auto expected = gdwg::graph<std::string, int>{"how", "are", "you"};
+		expected.insert_edge("how", "are", 1);
+		expected.insert_edge("how", "you", 2);
+		expected.insert_edge("you", "you", 4);
+		expected.insert_edge("are", "you", 3);
+		CHECK(g == expected);
+	}
+
+	SECTION("Empty edge list") {
+		auto in = std::istringstream(" \n\t");
+		CHECK(gdwg::parse_graph<int, int>(in, gdwg::graph_format::edge_list).empty());
+	}
+
+	SECTION("Errors report the line") {
+		auto const parse_edge_list = [](std::istream& is) {
+			return gdwg::parse_graph<int, int>(is, gdwg::graph_format::edge_list);
+		};
+		auto const parse_adjacency = [](std::istream& is) { return gdwg::parse_graph<int, int>(is); };
+		auto in = std::istringstream("1 2 3\n4 5 6\n7 x 9\n");
+		CHECK_THROWS_MATCHES(parse_edge_list(in),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::parse_graph on malformed "
+		                                              "input at line 3"));
+
+		auto incomplete = std::istringstream("1 2 3\n4 5\n");
+		CHECK_THROWS_MATCHES(parse_edge_list(incomplete),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::parse_graph on malformed "
+		                                              "input at line 2"));
+
+		auto adjacency = std::istringstream("1 (\n  1 | 2\n  1 | two\n)\n");
+		CHECK_THROWS_MATCHES(parse_adjacency(adjacency),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::parse_graph on malformed "
+		                                              "input at line 3"));
+
+		auto undeclared = std::istringstream("1 (\n  2 | 2\n)\n");
+		CHECK_THROWS_MATCHES(parse_adjacency(undeclared),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::parse_graph when an edge's "
+		                                              "destination is not a node of the graph"));
+	}
+}
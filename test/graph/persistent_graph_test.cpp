@@ -0,0 +1,184 @@
+#include "gdwg/persistent_graph.hpp"
+#include <catch2/catch.hpp>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	template<typename G>
+	auto to_string(G const& g) -> std::string {
+		auto out = std::ostringstream{};
+		out << g;
+		return out.str();
+	}
+} // namespace
+
+TEST_CASE("Persistent graph") {
+	auto g = gdwg::persistent_graph<std::string, int>{"how", "are", "you"};
+	g.insert_edge("how", "are", 1);
+	g.insert_edge("how", "you", 2);
+	g.insert_edge("how", "you", 3);
+	g.insert_edge("are", "you", 4);
+
+	SECTION("Accessors") {
+		CHECK(g.is_node("how"));
+		CHECK_FALSE(g.is_node("?"));
+		CHECK(g.is_connected("how", "you"));
+		CHECK_FALSE(g.is_connected("you", "how"));
+		CHECK(g.weights("how", "you") == std::vector<int>{2, 3});
+		CHECK(g.connections("how") == std::vector<std::string>{"are", "you"});
+		CHECK(g.nodes() == std::vector<std::string>{"are", "how", "you"});
+		REQUIRE(g.find("how", "you", 3) != g.end());
+		CHECK((*g.find("how", "you", 3)).weight == 3);
+		CHECK(g.find("how", "you", 4) == g.end());
+		CHECK(g.find("?", "you", 4) == g.end());
+		CHECK_FALSE(g.insert_edge("how", "are", 1));
+		CHECK(to_string(g)
+		      == "are (\n  you | 4\n)\nhow (\n  are | 1\n  you | 2\n  you | 3\n)\nyou (\n)\n");
+	}
+
+	SECTION("Iteration skips nodes without edges") {
+		g.insert_node("a");
+		auto edges = std::vector<std::string>();
+		for (auto const& [from, to, weight] : g) {
+			edges.push_back(from + to + std::to_string(weight));
+		}
+		CHECK(edges == std::vector<std::string>{"areyou4", "howare1", "howyou2", "howyou3"});
+		auto const no_edges = gdwg::persistent_graph<int, int>{1, 2};
+		CHECK(no_edges.begin() == no_edges.end());
+	}
+
+	SECTION("Copies are independent versions") {
+		auto const before = g;
+		CHECK(g.erase_edge("how", "you", 2));
+		CHECK(g.erase_node("are"));
+		CHECK(g.insert_node("?"));
+		CHECK(g.insert_edge("?", "?", 5));
+		CHECK(to_string(g) == "? (\n  ? | 5\n)\nhow (\n  you | 3\n)\nyou (\n)\n");
+		CHECK(to_string(before)
+		      == "are (\n  you | 4\n)\nhow (\n  are | 1\n  you | 2\n  you | 3\n)\nyou (\n)\n");
+		CHECK_FALSE(before == g);
+		g = before;
+		CHECK(g == before);
+	}
+
+	SECTION("Iterators keep the version they came from") {
+		auto itor = g.find("how", "are", 1);
+		g.erase_edge("how", "you", 2);
+		g.insert_edge("you", "how", 9);
+		CHECK((*itor).to == "are");
+		++itor;
+		CHECK((*itor).to == "you");
+		CHECK((*itor).weight == 2);
+
+		auto source = std::make_unique<gdwg::persistent_graph<std::string, int>>(g);
+		auto first = source->begin();
+		source->erase_node("are");
+		source.reset();
+		auto edges = std::vector<std::string>();
+		for (; first != g.end(); ++first) {
+			auto const& [from, to, weight] = *first;
+			edges.push_back(from + to + std::to_string(weight));
+		}
+		CHECK(edges == std::vector<std::string>{"areyou4", "howare1", "howyou3", "youhow9"});
+	}
+
+	SECTION("Replace and merge") {
+		g.insert_edge("you", "you", 5);
+		auto const before = g;
+		CHECK(g.replace_node("you", "me"));
+		CHECK_FALSE(g.replace_node("how", "are"));
+		CHECK(to_string(g)
+		      == "are (\n  me | 4\n)\nhow (\n  are | 1\n  me | 2\n  me | 3\n)\nme (\n  me | 5\n)\n");
+		g.merge_replace_node("are", "how");
+		CHECK(to_string(g)
+		      == "how (\n  how | 1\n  me | 2\n  me | 3\n  me | 4\n)\nme (\n  me | 5\n)\n");
+		CHECK(before.is_node("you"));
+		CHECK(before.connections("are") == std::vector<std::string>{"you"});
+	}
+
+	SECTION("Errors leave the graph as it was") {
+		auto const before = g;
+		CHECK_THROWS_WITH(g.insert_edge("how", "?", 1),
+		                  "Cannot call gdwg::persistent_graph<N, E>::insert_edge when either src or "
+		                  "dst node does not exist");
+		CHECK_THROWS_WITH(g.erase_edge("?", "how", 1),
+		                  "Cannot call gdwg::persistent_graph<N, E>::erase_edge on src or dst if "
+		                  "they don't exist in the graph");
+		CHECK_THROWS_WITH(g.replace_node("?", "how"),
+		                  "Cannot call gdwg::persistent_graph<N, E>::replace_node on a node that "
+		                  "doesn't exist");
+		CHECK_THROWS_WITH(g.merge_replace_node("how", "?"),
+		                  "Cannot call gdwg::persistent_graph<N, E>::merge_replace_node on old or "
+		                  "new data if they don't exist in the graph");
+		CHECK_THROWS_AS(g.is_connected("how", "?"), std::runtime_error);
+		CHECK_THROWS_AS(g.weights("?", "how"), std::runtime_error);
+		CHECK_THROWS_AS(g.connections("?"), std::runtime_error);
+		CHECK(g == before);
+	}
+
+	SECTION("Conversion to and from graph") {
+		auto const plain = g.to_graph();
+		CHECK(to_string(plain) == to_string(g));
+		CHECK(gdwg::persistent_graph<std::string, int>(plain) == g);
+	}
+
+	SECTION("Clear") {
+		auto const before = g;
+		g.clear();
+		CHECK(g.empty());
+		CHECK(g.begin() == g.end());
+		CHECK_FALSE(before.empty());
+	}
+}
+
+TEST_CASE("Persistent graph versions match graph copies on random operations") {
+	// Keep every version, each made from a random earlier one, next to a graph built the same way.
+	auto versions = std::vector<gdwg::persistent_graph<int, int>>(1);
+	auto copies = std::vector<gdwg::graph<int, int>>(1);
+	auto rng = std::mt19937{2718};
+	auto value = std::uniform_int_distribution<int>{0, 49};
+	auto operation = std::uniform_int_distribution<int>{0, 7};
+	for (auto step = 0; step < 3000; ++step) {
+		auto const from = std::uniform_int_distribution<std::size_t>{0, versions.size() - 1}(rng);
+		auto version = versions[from];
+		auto copy = copies[from];
+		auto const a = value(rng);
+		auto const b = value(rng);
+		switch (operation(rng)) {
+		case 0:
+		case 1: REQUIRE(version.insert_node(a) == copy.insert_node(a)); break;
+		case 2:
+		case 3:
+			if (copy.is_node(a) and copy.is_node(b)) {
+				REQUIRE(version.insert_edge(a, b, step % 3) == copy.insert_edge(a, b, step % 3));
+			}
+			break;
+		case 4:
+			if (copy.is_node(a) and copy.is_node(b)) {
+				REQUIRE(version.erase_edge(a, b, step % 3) == copy.erase_edge(a, b, step % 3));
+			}
+			break;
+		case 5: REQUIRE(version.erase_node(a) == copy.erase_node(a)); break;
+		case 6:
+			if (copy.is_node(a)) {
+				REQUIRE(version.replace_node(a, b) == copy.replace_node(a, b));
+			}
+			break;
+		default:
+			if (copy.is_node(a) and copy.is_node(b)) {
+				version.merge_replace_node(a, b);
+				copy.merge_replace_node(a, b);
+			}
+			break;
+		}
+		versions.push_back(std::move(version));
+		copies.push_back(std::move(copy));
+	}
+	for (auto i = std::size_t{0}; i < versions.size(); ++i) {
+		REQUIRE(to_string(versions[i]) == to_string(copies[i]));
+		REQUIRE(versions[i].to_graph() == copies[i]);
+	}
+}
@@ -0,0 +1,113 @@
+#include "gdwg/shortest_paths.hpp"
+#include <catch2/catch.hpp>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST_CASE("Shortest paths") {
+	auto g = gdwg::graph<std::string, double>{"sydney", "melbourne", "canberra", "perth", "hobart"};
+	g.insert_edge("sydney", "canberra", 3);
+	g.insert_edge("sydney", "melbourne", 9);
+	g.insert_edge("canberra", "melbourne", 6.5);
+	g.insert_edge("melbourne", "hobart", 5);
+	g.insert_edge("melbourne", "hobart", 2);
+	g.insert_edge("melbourne", "hobart", 8);
+	g.insert_edge("hobart", "sydney", 1);
+	auto const paths = gdwg::shortest_paths(g, "sydney");
+
+	SECTION("Distances") {
+		CHECK(paths.source() == "sydney");
+		CHECK(paths.distance("sydney") == 0);
+		CHECK(paths.distance("canberra") == 3);
+		CHECK(paths.distance("melbourne") == 9);
+		CHECK(paths.distance("hobart") == 11);
+	}
+
+	SECTION("Predecessors and paths") {
+		CHECK(paths.predecessor("sydney") == std::nullopt);
+		CHECK(paths.predecessor("hobart") == "melbourne");
+		CHECK(paths.path("sydney") == std::vector<std::string>{"sydney"});
+		CHECK(paths.path("hobart") == std::vector<std::string>{"sydney", "melbourne", "hobart"});
+	}
+
+	SECTION("Unreachable nodes") {
+		CHECK(paths.is_reachable("hobart"));
+		CHECK_FALSE(paths.is_reachable("perth"));
+		CHECK(paths.predecessor("perth") == std::nullopt);
+		CHECK(paths.path("perth").empty());
+		CHECK_THROWS_MATCHES(paths.distance("perth"),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::shortest_path_tree<N, E>::"
+		                                              "distance if dst isn't reachable from the "
+		                                              "source"));
+	}
+
+	SECTION("Independent of later changes to the graph") {
+		g.erase_node("melbourne");
+		CHECK(paths.distance("hobart") == 11);
+	}
+
+	SECTION("Missing nodes") {
+		CHECK_THROWS_MATCHES(gdwg::shortest_paths(g, "darwin"),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::shortest_paths "
+		                                              "if src doesn't exist in the graph"));
+		CHECK_THROWS_MATCHES(paths.path("darwin"),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::shortest_path_tree<N, E>::"
+		                                              "path if dst doesn't exist in the graph"));
+	}
+
+	SECTION("Negative weights") {
+		g.insert_edge("canberra", "perth", -1);
+		CHECK_THROWS_MATCHES(gdwg::shortest_paths(g, "sydney"),
+		                     std::runtime_error,
+		                     Catch::Matchers::Message("Cannot call gdwg::shortest_paths "
+		                                              "on a graph with negative weights"));
+	}
+}
+
+TEST_CASE("Shortest paths match Bellman-Ford on random graphs") {
+	auto rng = std::mt19937{6771};
+	auto node = std::uniform_int_distribution<int>{0, 49};
+	auto weight = std::uniform_int_distribution<int>{0, 20};
+	for (auto trial = 0; trial < 10; ++trial) {
+		auto g = gdwg::graph<int, int>{};
+		for (auto i = 0; i < 50; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < 200; ++i) {
+			g.insert_edge(node(rng), node(rng), weight(rng));
+		}
+
+		auto expected = std::vector<std::optional<int>>(50);
+		auto const at = [&expected](int i) -> std::optional<int>& {
+			return expected[static_cast<std::size_t>(i)];
+		};
+		at(0) = 0;
+		for (auto round = 0; round < 50; ++round) {
+			for (auto const& [from, to, w] : g) {
+				if (at(from) and (not at(to) or *at(from) + w < *at(to))) {
+					at(to) = *at(from) + w;
+				}
+			}
+		}
+
+		auto const paths = gdwg::shortest_paths(g, 0);
+		for (auto i = 0; i < 50; ++i) {
+			auto const& want = at(i);
+			REQUIRE(paths.is_reachable(i) == want.has_value());
+			if (want) {
+				CHECK(paths.distance(i) == *want);
+				// The path's own length has to agree with the distance.
+				auto const path = paths.path(i);
+				auto length = 0;
+				for (auto j = std::size_t{1}; j < path.size(); ++j) {
+					length += g.weights(path[j - 1], path[j]).front();
+				}
+				CHECK(length == *want);
+			}
+		}
+	}
+}